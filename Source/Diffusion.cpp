@@ -47,6 +47,7 @@ int         Diffusion::do_reflux;
 int         Diffusion::max_order;
 int         Diffusion::scale_abec;
 int         Diffusion::tensor_max_order;
+int         Diffusion::reuse_operators;
 
 Vector<int>  Diffusion::is_diffusive;
 
@@ -94,6 +95,7 @@ Diffusion::Diffusion (Amr*               Parent,
         //
         Diffusion::max_order           = 2;
         Diffusion::tensor_max_order    = 2;
+        Diffusion::reuse_operators     = 1;
 
         ParmParse ppdiff("diffuse");
 
@@ -101,6 +103,7 @@ Diffusion::Diffusion (Amr*               Parent,
         ppdiff.query("scale_abec",          scale_abec);
         ppdiff.query("max_order",           max_order);
         ppdiff.query("tensor_max_order",    tensor_max_order);
+        ppdiff.query("reuse_operators",     reuse_operators);
 
         ppdiff.query("agglomeration", agglomeration);
         ppdiff.query("consolidation", consolidation);
@@ -176,6 +179,7 @@ Diffusion::echo_settings () const
         amrex::Print() << "   max_order           = " << max_order           << '\n';
         amrex::Print() << "   tensor_max_order    = " << tensor_max_order    << '\n';
         amrex::Print() << "   scale_abec          = " << scale_abec          << '\n';
+        amrex::Print() << "   reuse_operators     = " << reuse_operators     << '\n';
 
         amrex::Print() << "\n\n  From ns:\n";
         amrex::Print() << "   do_reflux           = " << do_reflux << '\n';
@@ -189,6 +193,147 @@ Diffusion::echo_settings () const
     }
 }
 
+void
+Diffusion::invalidateOperatorCache ()
+{
+    scalar_solvers.clear();
+    tensor_apply_op.reset();
+    tensor_solve_op.reset();
+}
+
+Diffusion::ScalarSolver&
+Diffusion::getScalarSolver (const Geometry&            geom,
+                            const BoxArray&            ba,
+                            const DistributionMapping& dm,
+                            const FabFactory<FArrayBox>& factory,
+                            int                        nComp,
+                            const BCRec&               bc,
+                            bool                       has_coarse_data,
+                            bool                       need_old_op)
+{
+    if (!reuse_operators) {
+        scalar_solvers.clear();
+    }
+
+    std::array<LinOpBCType,AMREX_SPACEDIM> mlmg_lobc;
+    std::array<LinOpBCType,AMREX_SPACEDIM> mlmg_hibc;
+    setDomainBC(mlmg_lobc, mlmg_hibc, bc); // Same for all comps, by assumption
+
+    std::vector<int> key{nComp, int(has_coarse_data)};
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        key.push_back(static_cast<int>(mlmg_lobc[idim]));
+        key.push_back(static_cast<int>(mlmg_hibc[idim]));
+    }
+
+    ScalarSolver& solver = scalar_solvers[key];
+
+#ifdef AMREX_USE_EB
+    const auto& ebf = &(dynamic_cast<EBFArrayBoxFactory const&>(factory));
+#else
+    amrex::ignore_unused(factory);
+#endif
+
+    //
+    // Operator at time n is only used for apply, so no coarsening.
+    //
+    if (need_old_op && !solver.opn)
+    {
+        LPInfo infon;
+        infon.setAgglomeration(agglomeration);
+        infon.setConsolidation(consolidation);
+        infon.setMaxCoarseningLevel(0);
+
+#ifdef AMREX_USE_EB
+        solver.opn = std::make_unique<MLEBABecLap>(Vector<Geometry>{geom}, Vector<BoxArray>{ba},
+                                                   Vector<DistributionMapping>{dm}, infon,
+                                                   Vector<EBFArrayBoxFactory const*>{ebf}, nComp);
+#else
+        solver.opn = std::make_unique<MLABecLaplacian>(Vector<Geometry>{geom}, Vector<BoxArray>{ba},
+                                                       Vector<DistributionMapping>{dm}, infon,
+                                                       Vector<FabFactory<FArrayBox> const*>{}, nComp);
+#endif
+        solver.opn->setMaxOrder(max_order);
+        solver.opn->setDomainBC(mlmg_lobc, mlmg_hibc);
+
+        solver.mgn = std::make_unique<MLMG>(*solver.opn);
+        solver.mgn->setVerbose(verbose);
+    }
+
+    if (!solver.opnp1)
+    {
+        LPInfo infonp1;
+        infonp1.setAgglomeration(agglomeration);
+        infonp1.setConsolidation(consolidation);
+
+#ifdef AMREX_USE_EB
+        solver.opnp1 = std::make_unique<MLEBABecLap>(Vector<Geometry>{geom}, Vector<BoxArray>{ba},
+                                                     Vector<DistributionMapping>{dm}, infonp1,
+                                                     Vector<EBFArrayBoxFactory const*>{ebf}, nComp);
+#else
+        solver.opnp1 = std::make_unique<MLABecLaplacian>(Vector<Geometry>{geom}, Vector<BoxArray>{ba},
+                                                         Vector<DistributionMapping>{dm}, infonp1,
+                                                         Vector<FabFactory<FArrayBox> const*>{}, nComp);
+#endif
+        solver.opnp1->setMaxOrder(max_order);
+        solver.opnp1->setDomainBC(mlmg_lobc, mlmg_hibc);
+
+        solver.mgnp1 = std::make_unique<MLMG>(*solver.opnp1);
+        if (use_hypre)
+        {
+            solver.mgnp1->setBottomSolver(MLMG::BottomSolver::hypre);
+            solver.mgnp1->setBottomVerbose(hypre_verbose);
+        }
+        solver.mgnp1->setMaxFmgIter(max_fmg_iter);
+        solver.mgnp1->setVerbose(verbose);
+    }
+
+    return solver;
+}
+
+Diffusion::TensorOp&
+Diffusion::getTensorOp (bool single_level)
+{
+    std::unique_ptr<TensorOp>& op = single_level ? tensor_apply_op : tensor_solve_op;
+
+    if (!reuse_operators) {
+        op.reset();
+    }
+
+    if (!op)
+    {
+        LPInfo info;
+        info.setAgglomeration(agglomeration);
+        info.setConsolidation(consolidation);
+        if (single_level) {
+            info.setMaxCoarseningLevel(0);
+        }
+
+#ifdef AMREX_USE_EB
+        const auto& ebf = &dynamic_cast<EBFArrayBoxFactory const&>(navier_stokes->Factory());
+        op = std::make_unique<MLEBTensorOp>(Vector<Geometry>{navier_stokes->Geom()},
+                                            Vector<BoxArray>{grids},
+                                            Vector<DistributionMapping>{dmap}, info,
+                                            Vector<EBFArrayBoxFactory const*>{ebf});
+#else
+        op = std::make_unique<MLTensorOp>(Vector<Geometry>{navier_stokes->Geom()},
+                                          Vector<BoxArray>{grids},
+                                          Vector<DistributionMapping>{dmap}, info);
+#endif
+
+        // create right container
+        Array<LinOpBCType,AMREX_SPACEDIM> mlmg_lobc[AMREX_SPACEDIM];
+        Array<LinOpBCType,AMREX_SPACEDIM> mlmg_hibc[AMREX_SPACEDIM];
+        // fill it
+        for (int i=0; i<AMREX_SPACEDIM; i++)
+            setDomainBC(mlmg_lobc[i], mlmg_hibc[i], Xvel+i);
+        // pass to op
+        op->setDomainBC({AMREX_D_DECL(mlmg_lobc[0],mlmg_lobc[1],mlmg_lobc[2])},
+                        {AMREX_D_DECL(mlmg_hibc[0],mlmg_hibc[1],mlmg_hibc[2])});
+    }
+
+    return *op;
+}
+
 Real
 Diffusion::get_scaled_abs_tol (const MultiFab& rhs,
                                Real            reduction) //const
@@ -309,51 +454,13 @@ Diffusion::diffuse_scalar (const Vector<MultiFab*>&  S_old,
       Solnc->define(*bac, *dmc, nComp, 0, MFInfo(), S_new[1]->Factory());
     }
 
-    std::array<LinOpBCType,AMREX_SPACEDIM> mlmg_lobc;
-    std::array<LinOpBCType,AMREX_SPACEDIM> mlmg_hibc;
-
     //
-    // Create operator at time n and n+1
+    // Get operators at time n and n+1. These are cached across calls and
+    // only rebuilt after a regrid or restart.
     //
-    LPInfo infon;
-    infon.setAgglomeration(agglomeration);
-    infon.setConsolidation(consolidation);
-    infon.setMaxCoarseningLevel(0);
-
-#ifdef AMREX_USE_EB
-    const auto& ebf = &(dynamic_cast<EBFArrayBoxFactory const&>(factory));
-    MLEBABecLap opn({geom}, {ba}, {dm}, infon, {ebf}, nComp);
-#else
-    MLABecLaplacian opn({geom}, {ba}, {dm}, infon, {}, nComp);
-#endif
-
-    opn.setMaxOrder(max_order);
-    MLMG mgn(opn);
-    mgn.setVerbose(verbose);
-
-    LPInfo infonp1;
-    infonp1.setAgglomeration(agglomeration);
-    infonp1.setConsolidation(consolidation);
-
-#ifdef AMREX_USE_EB
-    MLEBABecLap opnp1({geom}, {ba}, {dm}, infonp1, {ebf}, nComp);
-#else
-    MLABecLaplacian opnp1({geom}, {ba}, {dm}, infonp1, {}, nComp);
-#endif
-    opnp1.setMaxOrder(max_order);
-
-    MLMG mgnp1(opnp1);
-    if (use_hypre)
-    {
-      mgnp1.setBottomSolver(MLMG::BottomSolver::hypre);
-      mgnp1.setBottomVerbose(hypre_verbose);
-    }
-    mgnp1.setMaxFmgIter(max_fmg_iter);
-    mgnp1.setVerbose(verbose);
-
-    setDomainBC(mlmg_lobc, mlmg_hibc, bc); // Same for all comps, by assumption
-    opn.setDomainBC(mlmg_lobc, mlmg_hibc);
-    opnp1.setDomainBC(mlmg_lobc, mlmg_hibc);
+    const bool need_old_op = add_old_time_divFlux && be_cn_theta!=1;
+    ScalarSolver& solver = getScalarSolver(geom, ba, dm, factory, nComp, bc,
+                                           has_coarse_data, need_old_op);
 
     if (verbose)
     {
@@ -363,7 +470,10 @@ Diffusion::diffuse_scalar (const Vector<MultiFab*>&  S_old,
 
     int sigma = S_comp;
 
-    if (add_old_time_divFlux && be_cn_theta!=1) {
+    if (need_old_op) {
+        ScalarOp& opn = *solver.opn;
+        MLMG&     mgn = *solver.mgn;
+
         Real a = 0.0;
         Real b = -(1.0-be_cn_theta)*dt;
 
@@ -426,7 +536,7 @@ Diffusion::diffuse_scalar (const Vector<MultiFab*>&  S_old,
             rhs_tmp.setVal(0.);
             mgn.apply({&rhs_tmp},{&Soln});
 
-            auto const& weights = ebf->getVolFrac();
+            auto const& weights = dynamic_cast<EBFArrayBoxFactory const&>(factory).getVolFrac();
             bool use_wts_in_divnc = true;
             single_level_weighted_redistribute(rhs_tmp, Rhs, weights, 0, nComp, geom, use_wts_in_divnc);
         } else
@@ -488,6 +598,9 @@ Diffusion::diffuse_scalar (const Vector<MultiFab*>&  S_old,
         });
     }
 
+    ScalarOp& opnp1 = *solver.opnp1;
+    MLMG&     mgnp1 = *solver.mgnp1;
+
     //
     // Set C&F solutions, levelBCs and CoarseFineBCs
     //
@@ -703,30 +816,12 @@ Diffusion::diffuse_tensor_velocity (Real                   dt,
       Real       b = -(1.0-be_cn_theta)*dt;
 
       {
-         LPInfo info;
-         info.setAgglomeration(agglomeration);
-         info.setConsolidation(consolidation);
-         info.setMaxCoarseningLevel(0);
-
 #ifdef AMREX_USE_EB
          auto const* ebf = &(dynamic_cast<EBFArrayBoxFactory const&>(navier_stokes->Factory()));
-         MLEBTensorOp tensorop({navier_stokes->Geom()}, {grids}, {dmap}, info, {ebf});
-#else
-         MLTensorOp tensorop({navier_stokes->Geom()}, {grids}, {dmap}, info);
 #endif
-
+         TensorOp& tensorop = getTensorOp(true);
          tensorop.setMaxOrder(tensor_max_order);
 
-         // create right container
-         Array<LinOpBCType,AMREX_SPACEDIM> mlmg_lobc[AMREX_SPACEDIM];
-         Array<LinOpBCType,AMREX_SPACEDIM> mlmg_hibc[AMREX_SPACEDIM];
-         // fill it
-         for (int i=0; i<AMREX_SPACEDIM; i++)
-           setDomainBC(mlmg_lobc[i], mlmg_hibc[i], Xvel+i);
-         // pass to op
-         tensorop.setDomainBC({AMREX_D_DECL(mlmg_lobc[0],mlmg_lobc[1],mlmg_lobc[2])},
-                              {AMREX_D_DECL(mlmg_hibc[0],mlmg_hibc[1],mlmg_hibc[2])});
-
          // set coarse-fine BCs
          {
            MultiFab crsedata;
@@ -849,30 +944,9 @@ Diffusion::diffuse_tensor_velocity (Real                   dt,
       const Real tol_rel = visc_tol;
       const Real tol_abs = get_scaled_abs_tol(Rhs, visc_tol);
 
-      LPInfo info;
-      info.setAgglomeration(agglomeration);
-      info.setConsolidation(consolidation);
-      info.setMaxCoarseningLevel(100);
-
-#ifdef AMREX_USE_EB
-      const auto& ebf = &dynamic_cast<EBFArrayBoxFactory const&>(navier_stokes->Factory());
-      MLEBTensorOp tensorop({navier_stokes->Geom()}, {grids}, {dmap}, info, {ebf});
-#else
-      MLTensorOp tensorop({navier_stokes->Geom()}, {grids}, {dmap}, info);
-#endif
-
+      TensorOp& tensorop = getTensorOp(false);
       tensorop.setMaxOrder(tensor_max_order);
 
-      // create right container
-      Array<LinOpBCType,AMREX_SPACEDIM> mlmg_lobc[AMREX_SPACEDIM];
-      Array<LinOpBCType,AMREX_SPACEDIM> mlmg_hibc[AMREX_SPACEDIM];
-      // fill it
-      for (int i=0; i<AMREX_SPACEDIM; i++)
-         setDomainBC(mlmg_lobc[i], mlmg_hibc[i], Xvel+i);
-      // pass to op
-      tensorop.setDomainBC({AMREX_D_DECL(mlmg_lobc[0],mlmg_lobc[1],mlmg_lobc[2])},
-                           {AMREX_D_DECL(mlmg_hibc[0],mlmg_hibc[1],mlmg_hibc[2])});
-
       // set up level BCs
       {
          MultiFab crsedata;
@@ -1071,30 +1145,9 @@ Diffusion::diffuse_tensor_Vsync (MultiFab&              Vsync,
     const Real tol_rel = visc_tol;
     const Real tol_abs = -1;
 
-    LPInfo info;
-    info.setAgglomeration(agglomeration);
-    info.setConsolidation(consolidation);
-    //info.setMaxCoarseningLevel(100);
-
-#ifdef AMREX_USE_EB
-    const auto& ebf = &dynamic_cast<EBFArrayBoxFactory const&>(navier_stokes->Factory());
-    MLEBTensorOp tensorop({navier_stokes->Geom()}, {grids}, {dmap}, info, {ebf});
-#else
-    MLTensorOp tensorop({navier_stokes->Geom()}, {grids}, {dmap}, info);
-#endif
-
+    TensorOp& tensorop = getTensorOp(false);
     tensorop.setMaxOrder(tensor_max_order);
 
-    // create right container
-    Array<LinOpBCType,AMREX_SPACEDIM> mlmg_lobc[AMREX_SPACEDIM];
-    Array<LinOpBCType,AMREX_SPACEDIM> mlmg_hibc[AMREX_SPACEDIM];
-    // fill it
-    for (int i=0; i<AMREX_SPACEDIM; i++)
-      setDomainBC(mlmg_lobc[i], mlmg_hibc[i], Xvel+i);
-    // pass to op
-    tensorop.setDomainBC({AMREX_D_DECL(mlmg_lobc[0],mlmg_lobc[1],mlmg_lobc[2])},
-                         {AMREX_D_DECL(mlmg_hibc[0],mlmg_hibc[1],mlmg_hibc[2])});
-
     // set up level BCs
     if (level > 0) {
       tensorop.setCoarseFineBC(nullptr, crse_ratio[0]);
@@ -1700,28 +1753,9 @@ Diffusion::getTensorViscTerms (MultiFab&              visc_terms,
 
         // MLMG tensor solver
         {
-           LPInfo info;
-           info.setAgglomeration(agglomeration);
-           info.setConsolidation(consolidation);
-           info.setMaxCoarseningLevel(0);
-
-#ifdef AMREX_USE_EB
-           MLEBTensorOp tensorop({navier_stokes->Geom()}, {grids}, {dmap}, info, {ebf});
-#else
-           MLTensorOp tensorop({navier_stokes->Geom()}, {grids}, {dmap}, info);
-#endif
+           TensorOp& tensorop = getTensorOp(true);
            tensorop.setMaxOrder(tensor_max_order);
 
-           // create right container
-           Array<LinOpBCType,AMREX_SPACEDIM> mlmg_lobc[AMREX_SPACEDIM];
-           Array<LinOpBCType,AMREX_SPACEDIM> mlmg_hibc[AMREX_SPACEDIM];
-           // fill it
-           for (int i=0; i<AMREX_SPACEDIM; i++)
-             setDomainBC(mlmg_lobc[i], mlmg_hibc[i], Xvel+i);
-           // pass to op
-           tensorop.setDomainBC({AMREX_D_DECL(mlmg_lobc[0],mlmg_lobc[1],mlmg_lobc[2])},
-                                {AMREX_D_DECL(mlmg_hibc[0],mlmg_hibc[1],mlmg_hibc[2])});
-
            // set coarse-fine BCs
            {
               MultiFab crsedata;
@@ -31,6 +31,7 @@ int  MacProj::max_order = 4;
 int  MacProj::agglomeration = 1;
 int  MacProj::consolidation = 1;
 int  MacProj::max_fmg_iter = -1;
+int  MacProj::warm_start = 0;
 
 namespace
 {
@@ -73,6 +74,10 @@ MacProj::Initialize ()
     pp.query("consolidation", consolidation);
     pp.query("max_fmg_iter", max_fmg_iter);
     pp.query( "maxorder"      , max_order );
+    pp.query("warm_start", warm_start);
+    if (warm_start < 0 || warm_start > 2) {
+        amrex::Abort("mac_proj.warm_start must be 0, 1 or 2");
+    }
 #ifdef AMREX_USE_HYPRE
     if ( pp.contains("use_hypre") )
       amrex::Abort("use_hypre is no more. To use Hypre set mac_proj.bottom_solver = hypre.");
@@ -120,6 +125,12 @@ MacProj::MacProj (Amr*   _parent,
     phys_bc(_phys_bc),
     mac_phi_crse(_finest_level+1),
     mac_reg(_finest_level+1),
+    mac_phi_prev(_finest_level+1),
+    mac_phi_prev2(_finest_level+1),
+    mac_phi_time(_finest_level+1,0.0),
+    mac_phi_time2(_finest_level+1,0.0),
+    mac_phi_scale(_finest_level+1,1.0),
+    mac_phi_scale2(_finest_level+1,1.0),
     finest_level(_finest_level)
 {
     Initialize();
@@ -146,9 +157,20 @@ MacProj::install_level (int       level,
         LevelData.resize(finest_level+1);
         mac_phi_crse.resize(finest_level+1);
         mac_reg.resize(finest_level+1);
+        mac_phi_prev.resize(finest_level+1);
+        mac_phi_prev2.resize(finest_level+1);
+        mac_phi_time.resize(finest_level+1,0.0);
+        mac_phi_time2.resize(finest_level+1,0.0);
+        mac_phi_scale.resize(finest_level+1,1.0);
+        mac_phi_scale2.resize(finest_level+1,1.0);
     }
 
     LevelData[level] = level_data;
+    //
+    // New grids at this level, so the saved solutions are of no use.
+    //
+    mac_phi_prev[level].reset();
+    mac_phi_prev2[level].reset();
 
     if (level > 0)
     {
@@ -172,6 +194,20 @@ MacProj::setup (int level)
             mac_phi_crse[level]->setVal(0.0);
         }
     }
+
+    if (warm_start > 0)
+    {
+        const BoxArray& grids = LevelData[level]->boxArray();
+        const DistributionMapping& dmap = LevelData[level]->DistributionMap();
+        for (auto* phi : {&mac_phi_prev[level], &mac_phi_prev2[level]})
+        {
+            if (*phi != nullptr &&
+                ((*phi)->boxArray() != grids || (*phi)->DistributionMap() != dmap))
+            {
+                phi->reset();
+            }
+        }
+    }
 }
 
 void
@@ -179,6 +215,12 @@ MacProj::cleanup (int level)
 {
     if (level < parent->maxLevel())
         mac_phi_crse[level].reset();
+
+    if (level < static_cast<int>(mac_phi_prev.size()))
+    {
+        mac_phi_prev[level].reset();
+        mac_phi_prev2[level].reset();
+    }
 }
 
 //
@@ -253,6 +295,36 @@ MacProj::mac_project (int             level,
     }
 
     mac_phi->setVal(0.0);
+
+    const Real rhs_scale = 2.0/dt;
+    //
+    // Initial guess for the solve. With mac_proj.warm_start = 1 it is the
+    // previous solution at this level, and with warm_start = 2 it is the
+    // previous two solutions linearly extrapolated to this time. The solve
+    // scales the coefficients by 1/rhs_scale = dt/2, so mac_phi scales with
+    // rhs_scale: each saved solution is multiplied by the ratio of this
+    // rhs_scale to the one it was solved with. Only the valid region is
+    // seeded: the ghost cells carry the Dirichlet values at outflow
+    // boundaries and must stay zero (or as set_outflow_bcs sets them).
+    //
+    if (warm_start > 0 && mac_phi_prev[level] != nullptr)
+    {
+        Real extrap = 0.0;
+        const Real dt12 = mac_phi_time[level] - mac_phi_time2[level];
+        if (warm_start == 2 && mac_phi_prev2[level] != nullptr && dt12 > 0.0)
+        {
+            extrap = (time - mac_phi_time[level]) / dt12;
+        }
+
+        const Real scale1 = rhs_scale / mac_phi_scale[level];
+        MultiFab::Saxpy(*mac_phi, (1.0+extrap)*scale1, *mac_phi_prev[level], 0, 0, 1, 0);
+
+        if (extrap != 0.0)
+        {
+            const Real scale2 = rhs_scale / mac_phi_scale2[level];
+            MultiFab::Saxpy(*mac_phi, -extrap*scale2, *mac_phi_prev2[level], 0, 0, 1, 0);
+        }
+    }
     //
     // HACK!!!
     //
@@ -269,8 +341,6 @@ MacProj::mac_project (int             level,
     //
     //  Set up the mac projection
     //
-    const Real rhs_scale = 2.0/dt;
-
     const MultiFab* cphi = (level == 0) ? nullptr : mac_phi_crse[level-1].get();
 
     // Set bcoefs to the average of Density at the faces
@@ -295,6 +365,22 @@ MacProj::mac_project (int             level,
            mac_tol, mac_abs_tol, rhs_scale,
            rho, divu, umac, mac_phi, fluxes);
 
+    if (warm_start > 0)
+    {
+        if (warm_start == 2) {
+            std::swap(mac_phi_prev[level], mac_phi_prev2[level]);
+            mac_phi_time2[level] = mac_phi_time[level];
+            mac_phi_scale2[level] = mac_phi_scale[level];
+        }
+        if (mac_phi_prev[level] == nullptr) {
+            mac_phi_prev[level] = std::make_unique<MultiFab>(grids, dmap, 1, 0, MFInfo(),
+                                                             LevelData[level]->Factory());
+        }
+        MultiFab::Copy(*mac_phi_prev[level], *mac_phi, 0, 0, 1, 0);
+        mac_phi_time[level] = time;
+        mac_phi_scale[level] = rhs_scale;
+    }
+
     //
     // Test that u_mac is divergence free
     //
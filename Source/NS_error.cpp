@@ -3,6 +3,8 @@
 #include <AMReX_ErrorList.H>
 #include <AMReX_ParmParse.H>
 
+#include <map>
+
 using std::string;
 
 using namespace amrex;
@@ -126,17 +128,45 @@ NavierStokes::errorEst (TagBoxArray& tags,
 
   NavierStokesBase::errorEst(tags,clearval,tagval,time,n_error_buf,ngrow);
 
+  //
+  // Indicators on the same field share one derived MultiFab: each field is
+  // derived (and filled) once, with the most ghost cells any of its
+  // indicators needs, and released after its last indicator.
+  //
+  std::map<std::string,int> field_ngrow;
+  std::map<std::string,int> field_last;
+  for (int j=0; j<errtags.size(); ++j) {
+    const std::string& field = errtags[j].Field();
+    if (! field.empty()) {
+      auto it = field_ngrow.find(field);
+      field_ngrow[field] = (it == field_ngrow.end()) ? errtags[j].NGrow()
+                                                     : std::max(it->second, errtags[j].NGrow());
+      field_last[field] = j;
+    }
+  }
+
+  std::map<std::string,std::unique_ptr<MultiFab>> derived;
+
   for (int j=0; j<errtags.size(); ++j) {
-    std::unique_ptr<MultiFab> mf;
-    if (! errtags[j].Field().empty()) {
-      mf = derive(errtags[j].Field(), time, errtags[j].NGrow());
+    const std::string& field = errtags[j].Field();
+    MultiFab* mf = nullptr;
+    if (! field.empty()) {
+      auto& dmf = derived[field];
+      if (! dmf) {
+        dmf = derive(field, time, field_ngrow[field]);
+      }
+      mf = dmf.get();
     }
     //
     // Create a derive to use ABecLap to compute grad
     // take level max here
     // add into errtags info for relative threshold ...
     //
-    errtags[j](tags,mf.get(),char(clearval),char(tagval),time,level,geom);
+    errtags[j](tags,mf,char(clearval),char(tagval),time,level,geom);
+
+    if (! field.empty() && field_last[field] == j) {
+      derived.erase(field);
+    }
   }
 
   //
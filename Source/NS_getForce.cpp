@@ -1,5 +1,6 @@
 
 #include <NavierStokesBase.H>
+#include <NSB_K.H>
 #include <AMReX_BLFort.H>
 
 
@@ -36,6 +37,10 @@ using namespace amrex;
 //   - For non-conservative variables, the force term computed here is
 //     divided by rho before use
 //
+// ns.fused_velocity_update evaluates the velocity forcing of this file in
+// place (default_force_k in NSB_K.H) and does not call getForce, so leave it
+// off when using a modified copy.
+//
 
 void
 NavierStokesBase::getForce (FArrayBox&       force,
@@ -122,17 +127,11 @@ NavierStokesBase::getForce (FArrayBox&       force,
      auto const& aux = Aux.array(auxScomp);
      const Real grav = gravity;
 
-     if ( std::abs(grav) > 0.0001) {
-       amrex::ParallelFor(bx, [frc, aux, grav]
-       AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+     if ( std::abs(grav) > default_force_min_gravity) {
+       amrex::ParallelFor(bx, AMREX_SPACEDIM, [frc, aux, grav]
+       AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept
        {
-         frc(i,j,k,0) = Real(0.0);
-#if ( AMREX_SPACEDIM == 2 )
-         frc(i,j,k,1) = grav*aux(i,j,k,0);
-#elif ( AMREX_SPACEDIM == 3 )
-         frc(i,j,k,1) = Real(0.0);
-         frc(i,j,k,2) = grav*aux(i,j,k,0);
-#endif
+         frc(i,j,k,n) = default_force_k(n, grav, aux(i,j,k,0));
        });
      }
      else {
@@ -0,0 +1,428 @@
+#include <NS_inflow.H>
+
+#include <AMReX_ParmParse.H>
+#include <AMReX_Utility.H>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+
+using namespace amrex;
+
+namespace
+{
+    bool initialized = false;
+    int  verbose     = 0;
+    Vector<std::unique_ptr<NSInflowPlanes>> planes;
+    //
+    // Guards the host state of the planes, for Views called from the threads
+    // of an OpenMP MFIter loop.
+    //
+    std::mutex views_mutex;
+
+    //
+    // Read the points (i1lo:i1hi, i2lo:i2hi) of record rec. Runs on the
+    // prefetch thread, so it reports failure with an empty result.
+    //
+    Vector<Real>
+    read_window (const std::string& bin, Long rec, Long npoints, int nfields, int n1,
+                 int i1lo, int i1hi, int i2lo, int i2hi)
+    {
+        std::ifstream ifs(bin, std::ios::in|std::ios::binary);
+        if (!ifs.good()) return {};
+
+        const Long nw = i1hi - i1lo + 1;
+        Vector<Real> buf(nw*(i2hi-i2lo+1)*nfields);
+        for (int j = i2lo; j <= i2hi; ++j)
+        {
+            const Long pos = (rec*npoints + Long(j)*n1 + i1lo)*nfields*Long(sizeof(Real));
+            ifs.seekg(static_cast<std::streamoff>(pos));
+            ifs.read(reinterpret_cast<char*>(buf.data() + (j-i2lo)*nw*nfields),
+                     static_cast<std::streamsize>(nw*nfields*sizeof(Real)));
+            if (!ifs) return {};
+        }
+        return buf;
+    }
+}
+
+void
+NSInflowPlanes::Initialize ()
+{
+    if (initialized) return;
+
+    ParmParse pp("inflow");
+    pp.query("v", verbose);
+
+    Vector<std::string> faces;
+    pp.queryarr("faces", faces);
+
+    for (const auto& face : faces)
+    {
+        const int dir = face.empty() ? -1 : face[0] - 'x';
+        const std::string side = face.size() == 3 ? face.substr(1) : std::string();
+        if (dir < 0 || dir >= AMREX_SPACEDIM || (side != "lo" && side != "hi")) {
+            amrex::Abort("inflow.faces: unknown face " + face);
+        }
+        const Orientation ori(dir, side == "lo" ? Orientation::low : Orientation::high);
+        planes.push_back(std::make_unique<NSInflowPlanes>(face, ori));
+    }
+
+    amrex::ExecOnFinalize(NSInflowPlanes::Finalize);
+
+    initialized = true;
+}
+
+void
+NSInflowPlanes::Finalize ()
+{
+    planes.clear();
+    initialized = false;
+}
+
+bool
+NSInflowPlanes::Active ()
+{
+    return !planes.empty();
+}
+
+InflowPlaneViews
+NSInflowPlanes::Views (const Box& bx, const Geometry& geom, Real time)
+{
+    std::lock_guard<std::mutex> lock(views_mutex);
+
+    InflowPlaneViews views{};
+    for (auto& p : planes) {
+        views[int(p->m_ori)] = p->view(bx, geom, time);
+    }
+    return views;
+}
+
+NSInflowPlanes::NSInflowPlanes (const std::string& a_face, Orientation a_ori)
+    : m_face(a_face), m_ori(a_ori)
+{
+    ParmParse pp("inflow." + m_face);
+
+    std::string file;
+    pp.get("file", file);
+    pp.query("time_offset", m_time_offset);
+    pp.query("loop", m_loop);
+    m_bin = file + ".bin";
+
+    //
+    // The header and record list of the sampler index.
+    //
+    const std::string idx = file + ".idx";
+    Vector<char> buf;
+    ParallelDescriptor::ReadAndBcastFile(idx, buf);
+    std::istringstream is(buf.dataPtr(), std::istringstream::in);
+
+    std::string type;
+    int real_bytes = 0;
+    Vector<std::pair<Real,Long>> records;
+    std::string line;
+    while (std::getline(is, line))
+    {
+        if (line.empty()) continue;
+        std::istringstream ls(line);
+        if (line[0] == '#')
+        {
+            std::string hash, key;
+            ls >> hash >> key;
+            if      (key == "type")       { ls >> type; }
+            else if (key == "npoints")    { ls >> m_npoints; }
+            else if (key == "real_bytes") { ls >> real_bytes; }
+            else if (key == "origin")     { ls >> m_origin; }
+            else if (key == "axis1")      { ls >> m_axis1; }
+            else if (key == "axis2")      { ls >> m_axis2; }
+            else if (key == "npts")       { ls >> m_n1; if (!(ls >> m_n2)) m_n2 = 1; }
+            else if (key == "fields")
+            {
+                std::string f;
+                while (ls >> f) m_fields.push_back(f);
+            }
+        }
+        else
+        {
+            Long step, rec;
+            Real time;
+            if (ls >> step >> time >> rec) records.emplace_back(time, rec);
+        }
+    }
+
+    const std::string where = "inflow." + m_face + ": " + idx;
+    if (type != "plane" && type != "line") {
+        amrex::Abort(where + " is not a plane or line sampler");
+    }
+    if (real_bytes != int(sizeof(Real))) {
+        amrex::Abort(where + " was written with a different Real precision");
+    }
+    if (Long(m_n1)*Long(m_n2) != m_npoints || m_fields.empty() || records.empty()) {
+        amrex::Abort(where + " has no usable records");
+    }
+
+    std::sort(records.begin(), records.end());
+    for (const auto& tr : records) {
+        m_times.push_back(tr.first);
+        m_recs.push_back(tr.second);
+    }
+
+    //
+    // The plane must be parallel to the face, and its axes orthogonal.
+    //
+    const int  dir = m_ori.coordDir();
+    const Real a1  = m_axis1.vectorLength();
+    const Real a2  = m_axis2.vectorLength();
+    if (std::abs(m_axis1[dir]) > 1.e-10*a1 || std::abs(m_axis2[dir]) > 1.e-10*a2 ||
+        std::abs(m_axis1.dotProduct(m_axis2)) > 1.e-10*a1*a2)
+    {
+        amrex::Abort(where + ": the plane is not parallel to the face");
+    }
+    //
+    // Store the axes scaled by 1/|axis|^2.
+    //
+    if (a1 > 0.) m_axis1 /= a1*a1;
+    if (a2 > 0.) m_axis2 /= a2*a2;
+
+    for (auto& f : m_field_of_comp) f = -1;
+
+    if (verbose)
+    {
+        Print() << "NSInflowPlanes: " << m_face << " from " << m_bin << ", "
+                << m_times.size() << " records, t = " << m_times.front()
+                << " .. " << m_times.back() << '\n';
+    }
+}
+
+NSInflowPlanes::~NSInflowPlanes ()
+{
+    if (m_pending.valid()) m_pending.wait();
+}
+
+bool
+NSInflowPlanes::coverBox (const Box& bx, const Geometry& geom)
+{
+    const int  dir = m_ori.coordDir();
+    const Box& dom = geom.Domain();
+
+    Box rb = bx;
+    if (m_ori.isLow())
+    {
+        if (bx.smallEnd(dir) >= dom.smallEnd(dir)) return false;
+        rb.setBig(dir, std::min(bx.bigEnd(dir), dom.smallEnd(dir)-1));
+    }
+    else
+    {
+        if (bx.bigEnd(dir) <= dom.bigEnd(dir)) return false;
+        rb.setSmall(dir, std::max(bx.smallEnd(dir), dom.bigEnd(dir)+1));
+    }
+
+    //
+    // Range of plane coordinates of the cell centers of rb.
+    //
+    Real smin = std::numeric_limits<Real>::max(), smax = std::numeric_limits<Real>::lowest();
+    Real tmin = smin, tmax = smax;
+    for (int c = 0; c < (1 << AMREX_SPACEDIM); ++c)
+    {
+        Real s = 0., t = 0.;
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            const int  i = ((c >> d) & 1) ? rb.bigEnd(d) : rb.smallEnd(d);
+            const Real x = geom.ProbLo(d) + (i+0.5)*geom.CellSize(d) - m_origin[d];
+            s += x*m_axis1[d];
+            t += x*m_axis2[d];
+        }
+        smin = std::min(smin, s); smax = std::max(smax, s);
+        tmin = std::min(tmin, t); tmax = std::max(tmax, t);
+    }
+
+    auto index_range = [] (Real lo, Real hi, int n, int& ilo, int& ihi)
+    {
+        ilo = static_cast<int>(std::floor(amrex::Clamp(lo, Real(0.), Real(1.))*(n-1)));
+        ihi = static_cast<int>(std::ceil (amrex::Clamp(hi, Real(0.), Real(1.))*(n-1)));
+        ilo = amrex::Clamp(ilo, 0, n-1);
+        ihi = amrex::Clamp(ihi, 0, n-1);
+    };
+    int i1lo, i1hi, i2lo, i2hi;
+    index_range(smin, smax, m_n1, i1lo, i1hi);
+    index_range(tmin, tmax, m_n2, i2lo, i2hi);
+
+    if (m_have_window &&
+        i1lo >= m_i1lo && i1hi <= m_i1hi && i2lo >= m_i2lo && i2hi <= m_i2hi)
+    {
+        return false;
+    }
+
+    if (m_have_window)
+    {
+        i1lo = std::min(i1lo, m_i1lo); i1hi = std::max(i1hi, m_i1hi);
+        i2lo = std::min(i2lo, m_i2lo); i2hi = std::max(i2hi, m_i2hi);
+    }
+    m_i1lo = i1lo; m_i1hi = i1hi;
+    m_i2lo = i2lo; m_i2hi = i2hi;
+    m_have_window = true;
+
+    return true;
+}
+
+void
+NSInflowPlanes::dropRecords (Real time)
+{
+    if (m_pending.valid()) m_pending.wait();
+    m_pending = std::future<Vector<Real>>();
+    m_pending_rec = -1;
+    for (auto& c : m_cache) {
+        m_retired.push_back(std::move(c.second));
+    }
+    m_retired_time = time;
+    m_cache.clear();
+}
+
+Real const*
+NSInflowPlanes::record (int r)
+{
+    auto it = m_cache.find(r);
+    if (it != m_cache.end()) {
+        return it->second->data();
+    }
+
+    Vector<Real> h;
+    if (m_pending_rec == r)
+    {
+        h = m_pending.get();
+        m_pending_rec = -1;
+    }
+    else
+    {
+        h = read_window(m_bin, m_recs[r], m_npoints, m_fields.size(), m_n1,
+                        m_i1lo, m_i1hi, m_i2lo, m_i2hi);
+    }
+    if (h.empty()) {
+        amrex::Abort("inflow." + m_face + ": failed to read " + m_bin);
+    }
+
+    auto dv = std::make_unique<Gpu::DeviceVector<Real>>(h.size());
+    Gpu::copyAsync(Gpu::hostToDevice, h.begin(), h.end(), dv->begin());
+    Gpu::streamSynchronize();
+
+    Real const* p = dv->data();
+    m_cache[r] = std::move(dv);
+    return p;
+}
+
+void
+NSInflowPlanes::prefetch (int r)
+{
+    if (m_cache.count(r) > 0 || m_pending_rec == r) return;
+
+    if (m_pending_rec >= 0)
+    {
+        //
+        // Only one read in flight; keep the previous one if it has finished.
+        //
+        if (m_pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return;
+        record(m_pending_rec);
+    }
+
+    m_pending_rec = r;
+    m_pending = std::async(std::launch::async, read_window, m_bin, m_recs[r], m_npoints,
+                           int(m_fields.size()), m_n1, m_i1lo, m_i1hi, m_i2lo, m_i2hi);
+}
+
+InflowPlaneView
+NSInflowPlanes::view (const Box& bx, const Geometry& geom, Real time)
+{
+    if (!m_fields_mapped)
+    {
+        const auto& desc = AmrLevel::get_desc_lst()[State_Type];
+        for (int c = 0; c < desc.nComp() && c < NavierStokes::NUM_STATE_MAX; ++c)
+        {
+            auto it = std::find(m_fields.begin(), m_fields.end(), desc.name(c));
+            m_field_of_comp[c] = (it == m_fields.end()) ? -1 : int(it - m_fields.begin());
+        }
+        m_fields_mapped = true;
+    }
+
+    //
+    // Free the records released by earlier calls. Calls at the same time come
+    // from one fill, whose other threads or kernels may still read them.
+    //
+    if (!m_retired.empty() && time != m_retired_time)
+    {
+        Gpu::streamSynchronize();
+        m_retired.clear();
+    }
+
+    if (coverBox(bx, geom)) {
+        dropRecords(time);
+    }
+
+    InflowPlaneView v;
+    if (!m_have_window) return v;
+
+    //
+    // The two records around the sample time.
+    //
+    const int nrec = m_times.size();
+    Real ts = time - m_time_offset;
+    if (m_loop && nrec > 1)
+    {
+        const Real period = m_times.back() - m_times.front();
+        ts = m_times.front() + std::fmod(ts - m_times.front(), period);
+        if (ts < m_times.front()) ts += period;
+    }
+
+    int  r0 = 0, r1 = 0;
+    Real w  = 0.;
+    if (nrec > 1 && ts >= m_times.back())
+    {
+        r0 = r1 = nrec-1;
+    }
+    else if (nrec > 1 && ts > m_times.front())
+    {
+        r1 = int(std::upper_bound(m_times.begin(), m_times.end(), ts) - m_times.begin());
+        r0 = r1-1;
+        w  = (ts - m_times[r0])/(m_times[r1] - m_times[r0]);
+    }
+
+    //
+    // Release the records behind, then read the next one ahead.
+    //
+    if (m_cache.size() > 3)
+    {
+        for (auto it = m_cache.begin(); it != m_cache.end(); ) {
+            if (it->first != r0 && it->first != r1) {
+                m_retired.push_back(std::move(it->second));
+                m_retired_time = time;
+                it = m_cache.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    v.d0 = record(r0);
+    v.d1 = record(r1);
+
+    int next = r1+1;
+    if (next >= nrec && m_loop) next = 0;
+    if (next < nrec) prefetch(next);
+
+    v.active  = 1;
+    v.nfields = m_fields.size();
+    v.n1      = m_n1;
+    v.n2      = m_n2;
+    v.i1lo    = m_i1lo; v.i1hi = m_i1hi;
+    v.i2lo    = m_i2lo; v.i2hi = m_i2hi;
+    v.w       = w;
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+        v.origin[d] = m_origin[d];
+        v.axis1[d]  = m_axis1[d];
+        v.axis2[d]  = m_axis2[d];
+    }
+    v.field = m_field_of_comp;
+
+    return v;
+}
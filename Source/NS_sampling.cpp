@@ -0,0 +1,528 @@
+
+#include <NS_sampling.H>
+#include <NavierStokesBase.H>
+
+#include <AMReX_BackgroundThread.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Utility.H>
+
+#include <unistd.h>
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+using namespace amrex;
+
+namespace
+{
+    bool initialized = false;
+    Vector<std::unique_ptr<NSSampler>> samplers;
+    std::unique_ptr<BackgroundThread> sample_writer;
+}
+
+void
+NSSampler::Initialize (Amr& amr)
+{
+    if (initialized) return;
+
+    ParmParse pp("ns");
+
+    Vector<std::string> names;
+    pp.queryarr("samplers", names);
+
+    //
+    // ns.dump_plane = k samples the level 0 velocity on the cell centers of
+    // the z (y in 2D) plane k into SLABS/vel.
+    //
+    int dump_plane = -1;
+    pp.query("dump_plane", dump_plane);
+    if (dump_plane >= 0)
+    {
+        const Geometry& geom = amr.Geom(0);
+        const Box&      dom  = geom.Domain();
+        constexpr int   zdir = AMREX_SPACEDIM-1;
+
+        if (dump_plane > dom.bigEnd(zdir)) {
+            amrex::Abort("ns.dump_plane is outside the domain");
+        }
+
+        Vector<Real> origin(AMREX_SPACEDIM), axis1(AMREX_SPACEDIM,0.0);
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            origin[d] = geom.ProbLo(d) + 0.5*geom.CellSize(d);
+        }
+        origin[zdir] = geom.ProbLo(zdir) + (dump_plane+0.5)*geom.CellSize(zdir);
+        axis1[0] = (dom.length(0)-1)*geom.CellSize(0);
+
+        ParmParse ppd("sampler.dump_plane");
+#if (AMREX_SPACEDIM == 3)
+        Vector<Real> axis2(AMREX_SPACEDIM,0.0);
+        axis2[1] = (dom.length(1)-1)*geom.CellSize(1);
+        ppd.add("type", std::string("plane"));
+        ppd.addarr("origin", origin);
+        ppd.addarr("axis1", axis1);
+        ppd.addarr("axis2", axis2);
+        ppd.addarr("npts", std::vector<int>{dom.length(0), dom.length(1)});
+#else
+        Vector<Real> end(origin);
+        end[0] += axis1[0];
+        ppd.add("type", std::string("line"));
+        ppd.addarr("start", origin);
+        ppd.addarr("end", end);
+        ppd.add("npts", dom.length(0));
+#endif
+        ppd.add("max_level", 0);
+        ppd.add("file", std::string("SLABS/vel"));
+
+        names.push_back("dump_plane");
+    }
+
+    for (const auto& name : names) {
+        samplers.push_back(std::make_unique<NSSampler>(amr, name));
+    }
+
+    if (!samplers.empty()) {
+        sample_writer = std::make_unique<BackgroundThread>();
+    }
+
+    amrex::ExecOnFinalize(NSSampler::Finalize);
+
+    initialized = true;
+}
+
+void
+NSSampler::Finalize ()
+{
+    // The destructor waits for the queued writes
+    sample_writer.reset();
+    samplers.clear();
+    initialized = false;
+}
+
+void
+NSSampler::SampleAll (Amr& amr, int step, Real time)
+{
+    Initialize(amr);
+
+    for (auto& s : samplers)
+    {
+        if (step % s->interval() == 0) {
+            s->sample(amr, step, time);
+        }
+    }
+}
+
+NSSampler::NSSampler (Amr& amr, const std::string& a_name)
+    :
+    m_name(a_name),
+    m_file("samples/" + a_name)
+{
+    ParmParse pp("sampler." + m_name);
+
+    auto get_point = [&pp] (const char* key)
+    {
+        Vector<Real> v;
+        pp.getarr(key, v, 0, AMREX_SPACEDIM);
+        return RealVect(v);
+    };
+
+    std::string type;
+    pp.get("type", type);
+    if (type == "plane")
+    {
+        m_type   = Plane;
+        m_origin = get_point("origin");
+        m_axis1  = get_point("axis1");
+        m_axis2  = get_point("axis2");
+        Vector<int> n;
+        pp.getarr("npts", n, 0, 2);
+        m_n1 = n[0];
+        m_n2 = n[1];
+    }
+    else if (type == "line")
+    {
+        m_type   = Line;
+        m_origin = get_point("start");
+        m_axis1  = get_point("end") - m_origin;
+        pp.get("npts", m_n1);
+    }
+    else if (type == "points")
+    {
+        m_type = Points;
+        Vector<Real> loc;
+        pp.getarr("locations", loc);
+        if (loc.empty() || loc.size() % AMREX_SPACEDIM != 0) {
+            amrex::Abort("sampler." + m_name + ".locations must hold AMREX_SPACEDIM coordinates per point");
+        }
+        for (int p = 0; p < static_cast<int>(loc.size()); p += AMREX_SPACEDIM) {
+            m_locations.push_back(RealVect(AMREX_D_DECL(loc[p], loc[p+1], loc[p+2])));
+        }
+    }
+    else
+    {
+        amrex::Abort("sampler." + m_name + ".type must be plane, line or points");
+    }
+
+    if (m_n1 < 1 || m_n2 < 1) {
+        amrex::Abort("sampler." + m_name + ".npts must be positive");
+    }
+    m_npoints = (m_type == Points) ? Long(m_locations.size()) : Long(m_n1)*Long(m_n2);
+
+    pp.query("interval",  m_interval);
+    pp.query("max_level", m_max_level);
+    pp.query("file",      m_file);
+    if (m_interval < 1) {
+        amrex::Abort("sampler." + m_name + ".interval must be at least 1");
+    }
+
+    //
+    // Fields are State_Type components, by name.
+    //
+    pp.queryarr("fields", m_fields);
+    if (m_fields.empty()) {
+        m_fields = {AMREX_D_DECL(std::string("x_velocity"), std::string("y_velocity"), std::string("z_velocity"))};
+    }
+    const StateDescriptor& desc = NavierStokesBase::get_desc_lst()[State_Type];
+    for (const auto& field : m_fields)
+    {
+        int comp = -1;
+        for (int n = 0; n < desc.nComp(); ++n) {
+            if (desc.name(n) == field) comp = n;
+        }
+        if (comp < 0) {
+            amrex::Abort("sampler." + m_name + ": unknown field " + field);
+        }
+        m_comps.push_back(comp);
+    }
+    m_comps_d.resize(m_comps.size());
+    Gpu::copyAsync(Gpu::hostToDevice, m_comps.begin(), m_comps.end(), m_comps_d.begin());
+    Gpu::streamSynchronize();
+
+    //
+    // A new run starts new files. A restart keeps the records of the existing
+    // ones up to the checkpoint step, dropping any written after it, and
+    // appends after them.
+    //
+    const std::string bin = m_file + ".bin";
+    const std::string idx = m_file + ".idx";
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        std::ifstream old_idx;
+        if (!amr.theRestartFile().empty()) {
+            old_idx.open(idx);
+        }
+
+        if (old_idx.good())
+        {
+            const Long restart_step = amr.levelSteps(0);
+            std::string kept;
+            std::string line;
+            while (std::getline(old_idx, line))
+            {
+                if (!line.empty() && line[0] != '#')
+                {
+                    std::istringstream ls(line);
+                    Long step, rec;
+                    Real time;
+                    if (!(ls >> step >> time >> rec) || step > restart_step) continue;
+                    m_nrecords = std::max(m_nrecords, rec+1);
+                }
+                kept += line;
+                kept += '\n';
+            }
+            old_idx.close();
+
+            std::ofstream idxf(idx, std::ios::out|std::ios::trunc);
+            if (!idxf.good()) amrex::FileOpenFailed(idx);
+            idxf << kept;
+
+            const Long rec_bytes = m_npoints*Long(m_comps.size())*Long(sizeof(Real));
+            if (::truncate(bin.c_str(), static_cast<off_t>(m_nrecords*rec_bytes)) != 0) {
+                amrex::FileOpenFailed(bin);
+            }
+        }
+        else
+        {
+            const auto slash = m_file.rfind('/');
+            if (slash != std::string::npos && slash > 0) {
+                if (!amrex::UtilCreateDirectory(m_file.substr(0, slash), 0755)) {
+                    amrex::CreateDirectoryFailed(m_file.substr(0, slash));
+                }
+            }
+
+            std::ofstream binf(bin, std::ios::out|std::ios::trunc|std::ios::binary);
+            if (!binf.good()) amrex::FileOpenFailed(bin);
+
+            std::ofstream idxf(idx, std::ios::out|std::ios::trunc);
+            if (!idxf.good()) amrex::FileOpenFailed(idx);
+
+            idxf << std::setprecision(17);
+            idxf << "# IAMR sampler " << m_name << '\n'
+                 << "# type " << type << '\n'
+                 << "# npoints " << m_npoints << '\n'
+                 << "# real_bytes " << sizeof(Real) << '\n'
+                 << "# fields";
+            for (const auto& field : m_fields) idxf << ' ' << field;
+            idxf << '\n';
+            if (m_type == Points)
+            {
+                for (const auto& x : m_locations) idxf << "# point " << x << '\n';
+            }
+            else
+            {
+                idxf << "# origin " << m_origin << '\n'
+                     << "# axis1 "  << m_axis1  << '\n';
+                if (m_type == Plane) idxf << "# axis2 " << m_axis2 << '\n';
+                idxf << "# npts " << m_n1;
+                if (m_type == Plane) idxf << ' ' << m_n2;
+                idxf << '\n';
+            }
+            idxf << "# Record r holds npoints*nfields values, point-major, at byte offset\n"
+                 << "# r*npoints*nfields*real_bytes of " << bin << ".\n"
+                 << "# Points outside the domain are written as zero.\n"
+                 << "# step time record\n";
+        }
+    }
+
+    ParallelDescriptor::Bcast(&m_nrecords, 1, ParallelDescriptor::IOProcessorNumber());
+    ParallelDescriptor::Barrier();
+}
+
+RealVect
+NSSampler::point (Long p) const
+{
+    if (m_type == Points) {
+        return m_locations[p];
+    }
+
+    const Long i = p % m_n1;
+    const Long j = p / m_n1;
+    const Real s = (m_n1 > 1) ? Real(i)/Real(m_n1-1) : 0.0;
+    const Real t = (m_n2 > 1) ? Real(j)/Real(m_n2-1) : 0.0;
+
+    return m_origin + s*m_axis1 + t*m_axis2;
+}
+
+bool
+NSSampler::gridsChanged (Amr& amr) const
+{
+    const int finest = (m_max_level < 0) ? amr.finestLevel()
+                                          : std::min(m_max_level, amr.finestLevel());
+
+    if (static_cast<int>(m_grids.size()) != finest+1) return true;
+
+    for (int lev = 0; lev <= finest; ++lev)
+    {
+        if (amr.boxArray(lev) != m_grids[lev] ||
+            amr.DistributionMap(lev) != m_dmap[lev]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+NSSampler::locate (Amr& amr)
+{
+    BL_PROFILE("NSSampler::locate()");
+
+    const int finest = (m_max_level < 0) ? amr.finestLevel()
+                                         : std::min(m_max_level, amr.finestLevel());
+    const int myproc = ParallelDescriptor::MyProc();
+    const bool first = m_grids.empty();
+
+    m_grids.resize(finest+1);
+    m_dmap.resize(finest+1);
+    for (int lev = 0; lev <= finest; ++lev)
+    {
+        m_grids[lev] = amr.boxArray(lev);
+        m_dmap[lev]  = amr.DistributionMap(lev);
+    }
+
+    //
+    // The owner of a point is the grid containing it on the finest level
+    // covering it. Points are visited in order, so the points this rank
+    // owns come out sorted by point index.
+    //
+    std::map<std::pair<int,int>,std::pair<Vector<IntVect>,Vector<int>>> found;
+    std::vector<std::pair<int,Box>> isects;
+    Long nlocal  = 0;
+    Long outside = 0;
+    const bool ioproc = ParallelDescriptor::IOProcessor();
+
+    m_runs.clear();
+    m_outside_runs.clear();
+
+    for (Long p = 0; p < m_npoints; ++p)
+    {
+        const RealVect x = point(p);
+        bool in_domain = true;
+
+        for (int lev = finest; lev >= 0 && in_domain; --lev)
+        {
+            const Geometry& geom = amr.Geom(lev);
+            const Box&      dom  = geom.Domain();
+
+            IntVect iv;
+            for (int d = 0; d < AMREX_SPACEDIM; ++d)
+            {
+                iv[d] = static_cast<int>(std::floor((x[d]-geom.ProbLo(d))*geom.InvCellSize(d)));
+                // A point on the upper domain face belongs to the last cell
+                if (iv[d] == dom.bigEnd(d)+1 && x[d] <= geom.ProbHi(d)) {
+                    iv[d] = dom.bigEnd(d);
+                }
+            }
+            if (!dom.contains(iv))
+            {
+                in_domain = false;
+                break;
+            }
+
+            m_grids[lev].intersections(Box(iv,iv), isects, true, 0);
+            if (!isects.empty())
+            {
+                const int gidx = isects[0].first;
+                if (m_dmap[lev][gidx] == myproc)
+                {
+                    auto& f = found[std::make_pair(lev,gidx)];
+                    f.first.push_back(iv);
+                    f.second.push_back(static_cast<int>(nlocal));
+
+                    if (!m_runs.empty() && m_runs.back().first + m_runs.back().second == p) {
+                        ++m_runs.back().second;
+                    } else {
+                        m_runs.emplace_back(p,1);
+                    }
+                    ++nlocal;
+                }
+                break;
+            }
+        }
+
+        if (!in_domain)
+        {
+            ++outside;
+            if (ioproc)
+            {
+                if (!m_outside_runs.empty() &&
+                    m_outside_runs.back().first + m_outside_runs.back().second == p) {
+                    ++m_outside_runs.back().second;
+                } else {
+                    m_outside_runs.emplace_back(p,1);
+                }
+            }
+        }
+    }
+
+    if (outside > 0 && first) {
+        amrex::Print() << "NSSampler " << m_name << ": " << outside
+                       << " points are outside the domain and will be written as zeros\n";
+    }
+
+    m_nlocal = nlocal;
+
+    m_groups.clear();
+    for (auto& kv : found)
+    {
+        auto g  = std::make_unique<Group>();
+        g->lev  = kv.first.first;
+        g->gidx = kv.first.second;
+        g->iv.resize(kv.second.first.size());
+        g->dst.resize(kv.second.second.size());
+        Gpu::copyAsync(Gpu::hostToDevice, kv.second.first.begin(), kv.second.first.end(), g->iv.begin());
+        Gpu::copyAsync(Gpu::hostToDevice, kv.second.second.begin(), kv.second.second.end(), g->dst.begin());
+        m_groups.push_back(std::move(g));
+    }
+    Gpu::streamSynchronize();
+}
+
+void
+NSSampler::sample (Amr& amr, int step, Real time)
+{
+    BL_PROFILE("NSSampler::sample()");
+
+    if (gridsChanged(amr)) {
+        locate(amr);
+    }
+
+    const int  nc  = static_cast<int>(m_comps.size());
+    const Long rec = m_nrecords++;
+
+    //
+    // Gather the points this rank owns into a buffer ordered by point index.
+    //
+    Gpu::DeviceVector<Real> dbuf(m_nlocal*nc);
+    Real*      out   = dbuf.data();
+    int const* comps = m_comps_d.data();
+
+    for (const auto& g : m_groups)
+    {
+        const MultiFab& S   = amr.getLevel(g->lev).get_new_data(State_Type);
+        auto const&     a   = S.const_array(g->gidx);
+        IntVect const*  ivp = g->iv.data();
+        int const*      dst = g->dst.data();
+
+        amrex::ParallelFor(static_cast<int>(g->iv.size()), [=]
+        AMREX_GPU_DEVICE (int q) noexcept
+        {
+            for (int c = 0; c < nc; ++c) {
+                out[Long(dst[q])*nc + c] = a(ivp[q], comps[c]);
+            }
+        });
+    }
+
+    auto hbuf = std::make_shared<Vector<Real>>(m_nlocal*nc);
+    Gpu::copyAsync(Gpu::deviceToHost, dbuf.begin(), dbuf.end(), hbuf->begin());
+    Gpu::streamSynchronize();
+
+    //
+    // Every rank writes its runs of points at their place in the record;
+    // the I/O processor also writes the points outside the domain as zeros,
+    // so every record is complete, and appends the record to the index.
+    //
+    const Long        pt_bytes = Long(nc)*Long(sizeof(Real));
+    const Long        rec_pos  = rec*m_npoints*pt_bytes;
+    const std::string bin      = m_file + ".bin";
+    const std::string idx      = m_file + ".idx";
+    const bool        ioproc   = ParallelDescriptor::IOProcessor();
+    const auto        runs     = std::make_shared<Vector<std::pair<Long,Long>>>(m_runs);
+    const auto        zeros    = std::make_shared<Vector<std::pair<Long,Long>>>(m_outside_runs);
+
+    sample_writer->Submit([=] ()
+    {
+        if (!runs->empty() || !zeros->empty())
+        {
+            std::fstream fs(bin, std::ios::in|std::ios::out|std::ios::binary);
+            if (!fs.good()) amrex::FileOpenFailed(bin);
+
+            Long q = 0;
+            for (const auto& r : *runs)
+            {
+                fs.seekp(static_cast<std::streamoff>(rec_pos + r.first*pt_bytes));
+                fs.write(reinterpret_cast<const char*>(hbuf->data() + q*nc),
+                         static_cast<std::streamsize>(r.second*pt_bytes));
+                q += r.second;
+            }
+
+            Long nzero = 0;
+            for (const auto& r : *zeros) nzero = std::max(nzero, r.second);
+            const Vector<Real> zbuf(nzero*nc, 0.0);
+            for (const auto& r : *zeros)
+            {
+                fs.seekp(static_cast<std::streamoff>(rec_pos + r.first*pt_bytes));
+                fs.write(reinterpret_cast<const char*>(zbuf.data()),
+                         static_cast<std::streamsize>(r.second*pt_bytes));
+            }
+        }
+
+        if (ioproc)
+        {
+            std::ofstream idxf(idx, std::ios::out|std::ios::app);
+            if (!idxf.good()) amrex::FileOpenFailed(idx);
+            idxf << step << ' ' << std::setprecision(17) << time << ' ' << rec << '\n';
+        }
+    });
+}
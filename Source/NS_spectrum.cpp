@@ -0,0 +1,165 @@
+#include <NavierStokesBase.H>
+
+#if (AMREX_SPACEDIM == 3) && defined(AMREX_USE_FFT)
+#include <AMReX_FFT.H>
+#endif
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+using namespace amrex;
+
+//
+// Kinetic energy spectrum of the level 0 velocity of a periodic domain.
+//
+// The velocity components are transformed with AMReX's distributed real to
+// complex FFT and the modal energies 0.5*|u_hat|^2 are binned into shells of
+// width dk = 2*pi/max(L) about the origin of wavenumber space. The same pass
+// accumulates the dissipation 2*nu*sum(k^2 e_k) and sum(e_k/k) for the integral
+// scale, so one row per sample holds
+//
+//   step time KE u' epsilon L lambda Re_lambda eta E(dk) E(2 dk) ... E(n/2 dk)
+//
+// where E(k) is the spectral density (shell energy / dk), u' = sqrt(2 KE/3),
+// L = pi/(2 u'^2) int E(k)/k dk, lambda = sqrt(15 nu u'^2/epsilon),
+// Re_lambda = u' lambda/nu and eta = (nu^3/epsilon)^(1/4). The kinematic
+// viscosity is visc_coef[Xvel] over the mean density.
+//
+void
+NavierStokesBase::kinetic_energy_spectrum ()
+{
+#if (AMREX_SPACEDIM == 3) && defined(AMREX_USE_FFT)
+    BL_PROFILE("NavierStokesBase::kinetic_energy_spectrum()");
+
+    AMREX_ALWAYS_ASSERT(level == 0);
+
+    if (!geom.isAllPeriodic()) {
+        amrex::Abort("ns.spectrum_interval requires a periodic domain");
+    }
+
+    const Real  time   = state[State_Type].curTime();
+    MultiFab&   S_new  = get_new_data(State_Type);
+    const Box&  domain = geom.Domain();
+    const IntVect n    = domain.length();
+    const Real  npts   = static_cast<Real>(domain.numPts());
+
+    const Real Lmax = std::max({geom.ProbLength(0), geom.ProbLength(1), geom.ProbLength(2)});
+    const Real dk   = 2.0*Math::pi<Real>()/Lmax;
+    const GpuArray<Real,3> kfac{2.0*Math::pi<Real>()/geom.ProbLength(0),
+                                2.0*Math::pi<Real>()/geom.ProbLength(1),
+                                2.0*Math::pi<Real>()/geom.ProbLength(2)};
+    //
+    // Shells up to the corner of the box of wavenumbers, followed in h_sums by
+    // three totals: energy, k^2 weighted energy and energy/k.
+    //
+    const int nshell = static_cast<int>(std::sqrt(Real(3.0))*n.max()/2) + 2;
+    const int i_ke   = nshell;
+    const int i_k2   = nshell+1;
+    const int i_ki   = nshell+2;
+
+    Gpu::DeviceVector<Real> shells_d(nshell, 0.0);
+    Real* AMREX_RESTRICT shells = shells_d.data();
+
+    ReduceOps<ReduceOpSum,ReduceOpSum,ReduceOpSum> reduce_op;
+    ReduceData<Real,Real,Real> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+
+    FFT::R2C<Real,FFT::Direction::forward> r2c(domain);
+    auto const& [cba, cdm] = r2c.getSpectralDataLayout();
+    FabArray<BaseFab<GpuComplex<Real>>> spec(cba, cdm, 1, 0);
+    MultiFab u(grids, dmap, 1, 0);
+
+    for (int d = 0; d < AMREX_SPACEDIM; d++)
+    {
+        MultiFab::Copy(u, S_new, Xvel+d, 0, 1, 0);
+        r2c.forward(u, spec);
+
+        //
+        // Modes 0 < i < n/2 stand for their complex conjugates as well. The
+        // three totals go through ReduceOps; only the shell bins use atomics,
+        // and those adds are spread over the nshell addresses. No OpenMP
+        // threading here since the host atomics are not thread safe.
+        //
+        for (MFIter mfi(spec); mfi.isValid(); ++mfi)
+        {
+            auto const& sp = spec.const_array(mfi);
+            reduce_op.eval(mfi.validbox(), reduce_data,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+            {
+                const int kx = i;
+                const int ky = (2*j <= n[1]) ? j : j-n[1];
+                const int kz = (2*k <= n[2]) ? k : k-n[2];
+                if (kx == 0 && ky == 0 && kz == 0) return {0.0, 0.0, 0.0};
+
+                const Real w  = (i == 0 || 2*i == n[0]) ? 1.0 : 2.0;
+                const Real e  = w*0.5*amrex::norm(sp(i,j,k))/(npts*npts);
+                const Real k2 = (kfac[0]*kx)*(kfac[0]*kx)
+                              + (kfac[1]*ky)*(kfac[1]*ky)
+                              + (kfac[2]*kz)*(kfac[2]*kz);
+                const Real km = std::sqrt(k2);
+                const int  s  = amrex::min(static_cast<int>(km/dk + 0.5), nshell-1);
+
+                Gpu::Atomic::AddNoRet(shells+s, e);
+                return {e, k2*e, e/km};
+            });
+        }
+    }
+
+    Vector<Real> h_sums(nshell+3);
+    Gpu::copy(Gpu::deviceToHost, shells_d.begin(), shells_d.end(), h_sums.begin());
+    {
+        ReduceTuple hv = reduce_data.value(reduce_op);
+        h_sums[i_ke] = amrex::get<0>(hv);
+        h_sums[i_k2] = amrex::get<1>(hv);
+        h_sums[i_ki] = amrex::get<2>(hv);
+    }
+    ParallelDescriptor::ReduceRealSum(h_sums.data(), nshell+3, ParallelDescriptor::IOProcessorNumber());
+
+    const Real rho_mean = S_new.sum(Density)/npts;
+
+    if (!ParallelDescriptor::IOProcessor()) return;
+
+    const Real nu      = visc_coef[Xvel]/rho_mean;
+    const Real ke      = h_sums[i_ke];
+    const Real uprime2 = 2.0*ke/3.0;
+    const Real uprime  = std::sqrt(uprime2);
+    const Real eps     = 2.0*nu*h_sums[i_k2];
+    const Real L_int   = (uprime2 > 0.0) ? 0.5*Math::pi<Real>()*h_sums[i_ki]/uprime2 : 0.0;
+    const Real lambda  = (eps > 0.0) ? std::sqrt(15.0*nu*uprime2/eps) : 0.0;
+    const Real re_lam  = (nu > 0.0) ? uprime*lambda/nu : 0.0;
+    const Real eta     = (eps > 0.0) ? std::pow(nu*nu*nu/eps, 0.25) : 0.0;
+    //
+    // Only the shells fully inside the box of resolved wavenumbers are written.
+    //
+    const int kmax = n.min()/2;
+
+    static bool first = true;
+    if (first)
+    {
+        first = false;
+        std::ifstream existing(spectrum_file);
+        if (!existing.good())
+        {
+            std::ofstream hdr(spectrum_file);
+            hdr << "# step time KE u' epsilon L lambda Re_lambda eta E(k) for k = m*dk, m = 1.."
+                << kmax << ", dk = " << std::setprecision(12) << dk << '\n';
+        }
+    }
+
+    std::ofstream os(spectrum_file, std::ios::app);
+    os << parent->levelSteps(0) << ' ' << std::setprecision(12) << time << std::scientific
+       << std::setprecision(8)
+       << ' ' << ke << ' ' << uprime << ' ' << eps << ' ' << L_int
+       << ' ' << lambda << ' ' << re_lam << ' ' << eta;
+    for (int s = 1; s <= kmax; s++) {
+        os << ' ' << h_sums[s]/dk;
+    }
+    os << '\n';
+
+    if (verbose) {
+        Print() << "NavierStokesBase::kinetic_energy_spectrum(): KE = " << ke
+                << " epsilon = " << eps << " Re_lambda = " << re_lam << '\n';
+    }
+#endif
+}
@@ -6,6 +6,7 @@
 #include <AMReX_BLProfiler.H>
 #include <NavierStokes.H>
 #include <NS_util.H>
+#include <NS_inflow.H>
 #include <iamr_constants.H>
 
 #ifdef BL_USE_VELOCITY
@@ -21,6 +22,8 @@
 using namespace amrex;
 
 int NavierStokes::set_plot_coveredCell_val = 1;
+int NavierStokes::batch_scalar_diffusion = 0;
+Vector<std::string> NavierStokes::sum_quantities{"mass", "trac", "energy"};
 
 namespace
 {
@@ -53,8 +56,27 @@ NavierStokes::Initialize ()
 
     NUM_SCALARS = NUM_STATE - Density;
 
+    ParmParse pp("ns");
+    pp.query("batch_scalar_diffusion", batch_scalar_diffusion);
+
+    pp.queryarr("sum_quantities", sum_quantities);
+    for (auto const& q : sum_quantities)
+    {
+        if (q != "mass"    && q != "trac"      && q != "trac2"    &&
+            q != "trac_sq" && q != "energy"    && q != "enstrophy" &&
+            q != "max_vort" && q != "div_l2"   && q != "max_divu")
+        {
+            amrex::Abort("ns.sum_quantities: unknown quantity " + q);
+        }
+        if (q == "trac2" && !do_trac2) {
+            amrex::Abort("ns.sum_quantities: trac2 requires ns.do_trac2 = 1");
+        }
+    }
+
     NavierStokes::Initialize_bcs();
 
+    NSInflowPlanes::Initialize();
+
     NavierStokes::Initialize_diffusivities();
 
     amrex::ExecOnFinalize(NavierStokes::Finalize);
@@ -894,6 +916,38 @@ NavierStokes::scalar_diffusion_update (Real dt,
 
     const Vector<BCRec>& theBCs = AmrLevel::desc_lst[State_Type].getBCs();
 
+    //
+    // Group the diffusive scalars into contiguous ranges that can share a
+    // single multi-component solve: same diffusion form and same BCs.
+    // Density is never batched since the other scalars may depend on it.
+    // Without ns.batch_scalar_diffusion each scalar is solved on its own.
+    //
+    Vector<std::pair<int,int>> groups;
+    for (int sigma = first_scalar; sigma <= last_scalar; sigma++)
+    {
+        if (!is_diffusive[sigma]) continue;
+
+        if (batch_scalar_diffusion && !groups.empty() && sigma != Density)
+        {
+            auto& grp = groups.back();
+            const int last = grp.first + grp.second - 1;
+            if (last == sigma-1 && last != Density &&
+                diffusionType[last] == diffusionType[sigma] &&
+                theBCs[last] == theBCs[sigma])
+            {
+                ++grp.second;
+                continue;
+            }
+        }
+        groups.emplace_back(sigma,1);
+    }
+
+    int max_ncomp = 0;
+    for (auto const& grp : groups) {
+        max_ncomp = std::max(max_ncomp, grp.second);
+    }
+    if (max_ncomp == 0) return;
+
     FluxBoxes fb_diffn, fb_diffnp1;
     MultiFab **cmp_diffn = nullptr, **cmp_diffnp1 = nullptr;
 
@@ -901,31 +955,32 @@ NavierStokes::scalar_diffusion_update (Real dt,
     MultiFab *alpha = nullptr;
     const int rhsComp = 0, alphaComp = 0, fluxComp  = 0;
 
-    FluxBoxes fb_fluxn  (this);
-    FluxBoxes fb_fluxnp1(this);
+    FluxBoxes fb_fluxn  (this, max_ncomp);
+    FluxBoxes fb_fluxnp1(this, max_ncomp);
     MultiFab** fluxn   = fb_fluxn.get();
     MultiFab** fluxnp1 = fb_fluxnp1.get();
 
-    Vector<int> diffuse_comp(1);
-
-    for (int sigma = first_scalar; sigma <= last_scalar; sigma++)
+    for (auto const& grp : groups)
     {
-      if (verbose) {
-          Print()<<"scalar_diffusion_update "<<sigma<<" of "<<last_scalar<<"\n";
-      }
+        const int sigma = grp.first;
+        const int ncomp = grp.second;
+
+        if (verbose) {
+            Print()<<"scalar_diffusion_update "<<sigma;
+            if (ncomp > 1) Print()<<" - "<<sigma+ncomp-1;
+            Print()<<" of "<<last_scalar<<"\n";
+        }
 
-      if (is_diffusive[sigma])
-      {
         if (be_cn_theta != 1)
         {
-          cmp_diffn = fb_diffn.define(this);
-          getDiffusivity(cmp_diffn, prev_time, sigma, 0, 1);
+          cmp_diffn = fb_diffn.define(this, ncomp);
+          getDiffusivity(cmp_diffn, prev_time, sigma, 0, ncomp);
         }
 
-        cmp_diffnp1 = fb_diffnp1.define(this);
-        getDiffusivity(cmp_diffnp1, curr_time, sigma, 0, 1);
+        cmp_diffnp1 = fb_diffnp1.define(this, ncomp);
+        getDiffusivity(cmp_diffnp1, curr_time, sigma, 0, ncomp);
 
-        diffuse_comp[0] = is_diffusive[sigma];
+        Vector<int> diffuse_comp(is_diffusive.begin()+sigma, is_diffusive.begin()+sigma+ncomp);
         const int rho_flag = Diffusion::set_rho_flag(diffusionType[sigma]);
 
         const bool add_old_time_divFlux = true;
@@ -934,7 +989,7 @@ NavierStokes::scalar_diffusion_update (Real dt,
         const int Rho_comp = Density;
         const int bc_comp  = sigma;
 
-        diffusion->diffuse_scalar (Sn, Sn, Snp1, Snp1, sigma, 1, Rho_comp,
+        diffusion->diffuse_scalar (Sn, Sn, Snp1, Snp1, sigma, ncomp, Rho_comp,
                                    prev_time,curr_time,be_cn_theta,Rh,rho_flag,
                                    fluxn,fluxnp1,fluxComp,delta_rhs,rhsComp,
                                    alpha,alphaComp,
@@ -957,24 +1012,24 @@ NavierStokes::scalar_diffusion_update (Real dt,
 
                 if (level < parent->finestLevel())
                 {
-                    fluxes.define(fluxn[d]->boxArray(), fluxn[d]->DistributionMap(), 1, 0, MFInfo(), Factory());
+                    fluxes.define(fluxn[d]->boxArray(), fluxn[d]->DistributionMap(), ncomp, 0, MFInfo(), Factory());
                 }
 
                 for (MFIter fmfi(*fluxn[d]); fmfi.isValid(); ++fmfi)
                 {
                     const Box& ebox = (*fluxn[d])[fmfi].box();
 
-                    fluxtot.resize(ebox,1);
+                    fluxtot.resize(ebox,ncomp);
                     Elixir fdata_i = fluxtot.elixir();
 
                     auto const& ftot = fluxtot.array();
                     auto const& fn   = fluxn[d]->array(fmfi);
                     auto const& fnp1 = fluxnp1[d]->array(fmfi);
 
-                    amrex::ParallelFor(ebox, [ftot, fn, fnp1 ]
-                    AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                    amrex::ParallelFor(ebox, ncomp, [ftot, fn, fnp1 ]
+                    AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
                     {
-                        ftot(i,j,k) = fn(i,j,k) + fnp1(i,j,k);
+                        ftot(i,j,k,n) = fn(i,j,k,n) + fnp1(i,j,k,n);
                     });
 
                     if (level < parent->finestLevel()) {
@@ -982,12 +1037,12 @@ NavierStokes::scalar_diffusion_update (Real dt,
                     }
 
                     if (level > 0) {
-                        getViscFluxReg().FineAdd(fluxtot,d,fmfi.index(),0,sigma,1,dt,RunOn::Gpu);
+                        getViscFluxReg().FineAdd(fluxtot,d,fmfi.index(),0,sigma,ncomp,dt,RunOn::Gpu);
                     }
                   } // mfi
 
                   if (level < parent->finestLevel()) {
-                    getLevel(level+1).getViscFluxReg().CrseInit(fluxes,d,0,sigma,1,-dt);
+                    getLevel(level+1).getViscFluxReg().CrseInit(fluxes,d,0,sigma,ncomp,-dt);
                   }
 
             } // d
@@ -997,10 +1052,9 @@ NavierStokes::scalar_diffusion_update (Real dt,
             fb_diffn.clear();
         }
         fb_diffnp1.clear();
-
-    }//end if(is_diffusive)
     }
 }
+
 void
 NavierStokes::velocity_diffusion_update (Real dt)
 {
@@ -1043,39 +1097,159 @@ NavierStokes::velocity_diffusion_update (Real dt)
     }
 }
 
+//
+// Compute the integral quantities in ns.sum_quantities over the valid
+// region of the AMR hierarchy (each level masked by the next finer one).
+// All quantities are accumulated in a single reduction pass per level and
+// reduced over the ranks together.
+//
 void
 NavierStokes::sum_integrated_quantities ()
 {
-    const int finest_level = parent->finestLevel();
-    const Real time = state[State_Type].curTime();
+    BL_PROFILE("NavierStokes::sum_integrated_quantities()");
+
+    const int  finest_level = parent->finestLevel();
+    const Real time         = state[State_Type].curTime();
+
+    auto wants = [] (const char* q)
+    {
+        return std::find(sum_quantities.begin(), sum_quantities.end(), q) != sum_quantities.end();
+    };
+    const bool need_vort = wants("enstrophy") || wants("max_vort");
+    const bool need_div  = wants("div_l2")    || wants("max_divu");
 
-    Vector<const MultiFab*> mf(finest_level+1);
+    //
+    // Sums: mass, trac, trac2, trac_sq, energy, enstrophy, div^2.
+    // Maxima: |vorticity|, |div u|.
+    //
+    ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum,
+              ReduceOpSum, ReduceOpSum, ReduceOpSum,
+              ReduceOpMax, ReduceOpMax> reduce_op;
+    ReduceData<Real, Real, Real, Real, Real, Real, Real, Real, Real> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
 
-    // Container to hold derived data
-    Vector<std::unique_ptr<MultiFab>> derived_mf(finest_level+1);
-    // Proper container for call to volumeWeightedSum
-    Vector<const MultiFab*> derived_mf_ptrs(finest_level+1);
+    const int  tracer  = Tracer;
+    const int  tracer2 = do_trac2 ? Tracer2 : Tracer;
 
     for (int lev = 0; lev <= finest_level; lev++)
     {
         NavierStokes& ns_level = getLevel(lev);
+        const MultiFab& S      = ns_level.get_new_data(State_Type);
+        const Geometry& lgeom  = parent->Geom(lev);
+
+        iMultiFab mask;
+        if (lev < finest_level) {
+            mask = makeFineMask(S.boxArray(), S.DistributionMap(),
+                                parent->boxArray(lev+1), parent->refRatio(lev), 1, 0);
+        } else {
+            mask.define(S.boxArray(), S.DistributionMap(), 1, 0);
+            mask.setVal(1);
+        }
+
+        std::unique_ptr<MultiFab> vort;
+        if (need_vort) {
+            vort = ns_level.derive("mag_vort",time,0);
+        }
+        MultiFab vel;
+        if (need_div) {
+            vel.define(S.boxArray(), S.DistributionMap(), AMREX_SPACEDIM, 1,
+                       MFInfo(), ns_level.Factory());
+            FillPatch(ns_level, vel, 1, time, State_Type, Xvel, AMREX_SPACEDIM, 0);
+        }
+
+        const auto dx    = lgeom.CellSizeArray();
+        const auto dxinv = lgeom.InvCellSizeArray();
+        const Real dv    = AMREX_D_TERM(dx[0],*dx[1],*dx[2]);
+        const bool is_rz = lgeom.IsRZ();
+        const Real rlo   = lgeom.ProbLo(0);
+        amrex::ignore_unused(is_rz, rlo);
+
+        for (MFIter mfi(S, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            auto const& s  = S.const_array(mfi);
+            auto const& m  = mask.const_array(mfi);
+            auto const& w  = need_vort ? vort->const_array(mfi) : s;
+            auto const& u  = need_div  ? vel.const_array(mfi)   : s;
+#ifdef AMREX_USE_EB
+            auto const& vf = ns_level.VolFrac()->const_array(mfi);
+#endif
+            reduce_op.eval(bx, reduce_data,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept -> ReduceTuple
+            {
+                if (m(i,j,k) == 0) {
+                    return {0.,0.,0.,0.,0.,0.,0.,0.,0.};
+                }
 
-        mf[lev] = &ns_level.get_new_data(State_Type);
-        derived_mf[lev] = ns_level.derive("energy",time,0);
-        derived_mf_ptrs[lev] = derived_mf[lev].get();
+                Real vol = dv;
+#if (AMREX_SPACEDIM == 2)
+                if (is_rz) {
+                    vol *= 2.0*Math::pi<Real>()*(rlo + (i+0.5)*dx[0]);
+                }
+#endif
+#ifdef AMREX_USE_EB
+                vol *= vf(i,j,k);
+#endif
+                const Real rho = s(i,j,k,Density);
+                const Real ke  = 0.5*rho*( AMREX_D_TERM( s(i,j,k,Xvel)*s(i,j,k,Xvel),
+                                                       + s(i,j,k,Yvel)*s(i,j,k,Yvel),
+                                                       + s(i,j,k,Zvel)*s(i,j,k,Zvel) ) );
+                const Real c   = s(i,j,k,tracer);
+
+                Real wmag = 0.0;
+                if (need_vort) {
+                    wmag = w(i,j,k);
+                }
+                Real divu = 0.0;
+                if (need_div) {
+                    divu = AMREX_D_TERM( 0.5*(u(i+1,j,k,0)-u(i-1,j,k,0))*dxinv[0],
+                                       + 0.5*(u(i,j+1,k,1)-u(i,j-1,k,1))*dxinv[1],
+                                       + 0.5*(u(i,j,k+1,2)-u(i,j,k-1,2))*dxinv[2] );
+#if (AMREX_SPACEDIM == 2)
+                    if (is_rz) {
+                        divu += u(i,j,k,0)/(rlo + (i+0.5)*dx[0]);
+                    }
+#endif
+#ifdef AMREX_USE_EB
+                    if (vf(i,j,k) == 0.0) divu = 0.0;
+#endif
+                }
+
+                return { rho*vol, c*vol, s(i,j,k,tracer2)*vol, c*c*vol, ke*vol,
+                         0.5*wmag*wmag*vol, divu*divu*vol,
+                         amrex::Math::abs(wmag), amrex::Math::abs(divu) };
+            });
+        }
     }
 
-    Real mass   = volumeWeightedSum(mf, Density,
-                                    parent->Geom(), parent->refRatio());
-    Real trac   = volumeWeightedSum(mf, Tracer,
-                                    parent->Geom(), parent->refRatio());
-    Real energy = volumeWeightedSum(derived_mf_ptrs, 0,
-                                    parent->Geom(), parent->refRatio());
+    ReduceTuple hv = reduce_data.value(reduce_op);
+
+    Real sums[7] = { amrex::get<0>(hv), amrex::get<1>(hv), amrex::get<2>(hv), amrex::get<3>(hv),
+                     amrex::get<4>(hv), amrex::get<5>(hv), amrex::get<6>(hv) };
+    Real maxs[2] = { amrex::get<7>(hv), amrex::get<8>(hv) };
+
+    const int IOProc = ParallelDescriptor::IOProcessorNumber();
+    ParallelDescriptor::ReduceRealSum(sums, 7, IOProc);
+    if (wants("max_vort") || wants("max_divu")) {
+        ParallelDescriptor::ReduceRealMax(maxs, 2, IOProc);
+    }
 
     Print() << '\n';
-    Print().SetPrecision(12) << "TIME= " << time << " MASS= " << mass << '\n';
-    Print().SetPrecision(12) << "TIME= " << time << " TRAC= " << trac << '\n';
-    Print().SetPrecision(12) << "TIME= " << time << " KINETIC ENERGY= " << energy << '\n';
+    for (auto const& q : sum_quantities)
+    {
+        std::string label;
+        Real        val = 0.0;
+        if      (q == "mass")      { label = "MASS";           val = sums[0]; }
+        else if (q == "trac")      { label = "TRAC";           val = sums[1]; }
+        else if (q == "trac2")     { label = "TRAC2";          val = sums[2]; }
+        else if (q == "trac_sq")   { label = "TRAC_SQ";        val = sums[3]; }
+        else if (q == "energy")    { label = "KINETIC ENERGY"; val = sums[4]; }
+        else if (q == "enstrophy") { label = "ENSTROPHY";      val = sums[5]; }
+        else if (q == "div_l2")    { label = "DIVU L2";        val = std::sqrt(sums[6]); }
+        else if (q == "max_vort")  { label = "MAX VORTICITY";  val = maxs[0]; }
+        else if (q == "max_divu")  { label = "MAX DIVU";       val = maxs[1]; }
+        Print().SetPrecision(12) << "TIME= " << time << ' ' << label << "= " << val << '\n';
+    }
 }
 
 void
@@ -1227,11 +1401,21 @@ NavierStokes::derive (const std::string& name,
                       Real               time,
                       int                ngrow)
 {
+    swapPlotState();
 #ifdef AMREX_PARTICLES
-    return ParticleDerive(name, time, ngrow);
+    auto mf = ParticleDerive(name, time, ngrow);
 #else
-    return AmrLevel::derive(name, time, ngrow);
+    auto mf = AmrLevel::derive(name, time, ngrow);
 #endif
+    swapPlotState();
+
+    if (const DeriveRec* rec = derive_lst.get(name))
+    {
+        for (int i = 0; i < rec->numDerive(); i++) {
+            reducePlotPrecision(rec->variableName(i), *mf, i);
+        }
+    }
+    return mf;
 }
 
 void
@@ -1688,18 +1872,9 @@ NavierStokes::mac_sync ()
 
     if (level > 0) incrRhoAvg(Ssync,Density-AMREX_SPACEDIM,1.0);
     //
-    // Get boundary conditions.
+    // Get boundary conditions: the domain BCs of the scalars.
     //
-    const auto N = int(grids.size());
-
-    Vector<int*>         sync_bc(N);
-    Vector< Vector<int> > sync_bc_array(N);
-
-    for (int i = 0; i < N; i++)
-    {
-      sync_bc_array[i] = getBCArray(State_Type,i,Density,numscal);
-      sync_bc[i]       = sync_bc_array[i].dataPtr();
-    }
+    const BCRec* sync_bc = &(desc_lst[State_Type].getBCs()[Density]);
     //
     // Interpolate the sync correction to the finer levels,
     //  and update rho_ctime, rhoAvg at those levels.
@@ -1715,7 +1890,7 @@ NavierStokes::mac_sync ()
       sync_incr.setVal(0.0);
 
       SyncInterp(Ssync,level,sync_incr,lev,ratio,0,0,
-         numscal,1,mult,sync_bc.dataPtr());
+         numscal,1,mult,sync_bc);
 
       MultiFab& Sf_new = fine_lev.get_new_data(State_Type);
       MultiFab::Add(Sf_new,sync_incr,0,Density,numscal,0);
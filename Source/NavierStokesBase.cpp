@@ -5,15 +5,24 @@
 #include <AMReX_PhysBCFunct.H>
 #include <AMReX_MLNodeLaplacian.H>
 #include <AMReX_FillPatchUtil.H>
+#include <AMReX_AsyncOut.H>
 #include <NavierStokesBase.H>
 #include <NSB_K.H>
 #include <NS_util.H>
+#include <NS_sampling.H>
 #include <iamr_constants.H>
 
 #include <hydro_godunov.H>
 #include <hydro_bds.H>
 #include <hydro_utils.H>
 
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <sstream>
+
+#include <unistd.h>
+
 #ifdef AMREX_USE_EB
 #include <AMReX_EBAmrUtil.H>
 #include <AMReX_EBInterpolater.H>
@@ -103,10 +112,14 @@ Real NavierStokesBase::init_dt            = -1.0;
 Real NavierStokesBase::fixed_dt           = -1.0;
 bool NavierStokesBase::stop_when_steady   = false;
 Real NavierStokesBase::steady_tol         = 1.0e-10;
+std::string NavierStokesBase::steady_norm = "speed";
+int  NavierStokesBase::steady_per_component = 0;
 int  NavierStokesBase::initial_iter       = false;
 int  NavierStokesBase::initial_step       = false;
 Real NavierStokesBase::dt_cutoff          = 0.0;
 int  NavierStokesBase::sum_interval       = -1;
+int  NavierStokesBase::spectrum_interval  = -1;
+std::string NavierStokesBase::spectrum_file("spectrum.dat");
 
 int  NavierStokesBase::radius_grow = 1;
 int  NavierStokesBase::verbose     = 0;
@@ -139,11 +152,13 @@ int         NavierStokesBase::Nbuf_outflow              = 1;
 int         NavierStokesBase::do_denminmax              = 0;
 int         NavierStokesBase::do_scalminmax             = 0;
 int         NavierStokesBase::getForceVerbose           = 0;
+int         NavierStokesBase::fused_velocity_update     = 0;
 int         NavierStokesBase::do_LES                    = 0;
 int         NavierStokesBase::getLESVerbose             = 0;
 std::string NavierStokesBase::LES_model                 = "Smagorinsky";
 Real        NavierStokesBase::smago_Cs_cst              = 0.18;
 Real        NavierStokesBase::sigma_Cs_cst              = 1.5;
+Real        NavierStokesBase::wale_Cw_cst               = 0.5;
 
 amrex::Vector<amrex::Real> NavierStokesBase::time_avg;
 amrex::Vector<amrex::Real> NavierStokesBase::time_avg_fluct;
@@ -190,9 +205,50 @@ int NavierStokesBase::average_in_checkpoint = -1;
 namespace
 {
     bool initialized = false;
-    int  dump_plane  = -1;
-    std::string dump_plane_name("SLABS/vel-");
     bool benchmarking = false;
+    //
+    // With ns.async_checkpoint, checkpoints are written through AMReX's
+    // asynchronous output; checkpoint_done tracks the last one.
+    //
+    int  async_checkpoint = 0;
+    std::future<void> checkpoint_done;
+    //
+    // Plotfile precision. With plot_precision = float the FABs are stored as
+    // 32 bit reals. The plot variables in plot_reduced_vars are additionally
+    // rounded to plot_mantissa_bits bits of mantissa (10 matches half
+    // precision) and, if plot_abs_tol > 0, to a multiple of 2*plot_abs_tol,
+    // so that their low order bits are zero and compress well.
+    //
+    bool plot_float = false;
+    Vector<std::string> plot_reduced_vars;
+    int  plot_mantissa_bits = 10;
+    Real plot_abs_tol = 0.0;
+    bool writing_reduced_plot = false;
+
+    //
+    // Round component comp of mf: snap to a multiple of 2*plot_abs_tol if
+    // plot_abs_tol > 0, then keep plot_mantissa_bits bits of mantissa. The
+    // error is at most plot_abs_tol + 2^-(plot_mantissa_bits+1)*|value|.
+    //
+    void reduce_precision (MultiFab& mf, int comp)
+    {
+        const Real mscale = std::ldexp(Real(1.0), plot_mantissa_bits+1);
+        const Real qstep  = 2.0*plot_abs_tol;
+        auto const& ma = mf.arrays();
+        amrex::ParallelFor(mf, mf.nGrowVect(), [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) noexcept
+        {
+            Real& v = ma[box_no](i,j,k,comp);
+            if (qstep > 0.0) {
+                v = std::round(v/qstep)*qstep;
+            }
+            if (v != 0.0 && std::isfinite(v)) {
+                int e;
+                Real m = std::frexp(v,&e);
+                v = std::ldexp(std::round(m*mscale)/mscale,e);
+            }
+        });
+        Gpu::streamSynchronize();
+    }
 }
 
 #ifdef AMREX_PARTICLES
@@ -212,6 +268,8 @@ namespace
 
     std::string      timestamp_dir                   ("Timestamps");
     std::vector<int> timestamp_indices;
+    int              timestamp_binary                = 0;
+    bool             timestamp_append                = false;
     std::string      particle_init_file;
     std::string      particle_restart_file;
     std::string      particle_output_file;
@@ -220,6 +278,219 @@ namespace
 }
 
 AmrTracerParticleContainer* NavierStokesBase::theNSPC () { return NSPC; }
+
+namespace
+{
+    //
+    // Per-rank binary trajectory file and its index, kept open and buffered
+    // between timestamps.
+    //
+    struct TimestampFiles
+    {
+        std::ofstream     bin;
+        std::ofstream     idx;
+        std::vector<char> buffer;
+    };
+    std::unique_ptr<TimestampFiles> timestamp_files;
+
+    std::string
+    timestamp_basename ()
+    {
+        std::string basename = timestamp_dir;
+
+        if (basename[basename.length()-1] != '/') basename += '/';
+
+        basename += "Timestamp";
+
+        return basename;
+    }
+
+    Long
+    timestamp_record_bytes (Long np, int nc)
+    {
+        return np*(Long(sizeof(Long)) + Long(sizeof(int))
+                   + AMREX_SPACEDIM*Long(sizeof(ParticleReal)) + nc*Long(sizeof(Real)));
+    }
+
+    //
+    // On restart, keep the records of this rank's binary trajectory file up
+    // to the checkpoint time, dropping any written after it, so that the run
+    // appends after them.
+    //
+    void
+    trim_binary_timestamp (Real restart_time)
+    {
+        const std::string name = amrex::Concatenate(timestamp_basename() + "_bin.", ParallelDescriptor::MyProc(), 5);
+
+        std::ifstream old_idx(name + ".idx");
+        if (!old_idx.good()) return;
+
+        Long end = 0;
+        std::string kept;
+        std::string line;
+        while (std::getline(old_idx, line))
+        {
+            if (!line.empty() && line[0] != '#')
+            {
+                std::istringstream ls(line);
+                Real time;
+                int lev, nc;
+                Long np, offset;
+                if (!(ls >> time >> lev >> np >> nc >> offset) || time > restart_time) continue;
+                end = std::max(end, offset + timestamp_record_bytes(np,nc));
+            }
+            kept += line;
+            kept += '\n';
+        }
+        old_idx.close();
+
+        std::ofstream idxf(name + ".idx", std::ios::out|std::ios::trunc);
+        if (!idxf.good()) amrex::FileOpenFailed(name + ".idx");
+        idxf << kept;
+
+        if (::truncate(name.c_str(), static_cast<off_t>(end)) != 0) {
+            amrex::FileOpenFailed(name);
+        }
+
+        timestamp_append = true;
+    }
+
+    //
+    // Interpolate the components of mf to the particles at level lev and
+    // append one record to the per-rank files basename_bin.<rank>(.idx).
+    // Without timestamp indices mf is undefined and the record only holds
+    // the ids, cpus and positions, as in the text files.
+    // A record holds, for its np particles, Long id[np], int cpu[np],
+    // ParticleReal pos[np][AMREX_SPACEDIM] and Real value[np][ncomp]; the
+    // index line gives time, level, np, ncomp and the byte offset of the record.
+    //
+    void
+    write_binary_timestamp (const std::string& basename, const MultiFab& mf,
+                            int lev, Real time)
+    {
+        BL_PROFILE("write_binary_timestamp()");
+
+        const Geometry& geom = NSPC->Geom(lev);
+        const auto      plo  = geom.ProbLoArray();
+        const auto      dxi  = geom.InvCellSizeArray();
+        const int       nc   = mf.ok() ? mf.nComp() : 0;
+
+        Long np = 0;
+        std::vector<Long> tile_offset;
+        for (TParIter pti(*NSPC, lev); pti.isValid(); ++pti)
+        {
+            tile_offset.push_back(np);
+            np += pti.numParticles();
+        }
+        if (np == 0) return;
+
+        Gpu::DeviceVector<Long>         ids(np);
+        Gpu::DeviceVector<int>          cpus(np);
+        Gpu::DeviceVector<ParticleReal> pos(np*AMREX_SPACEDIM);
+        Gpu::DeviceVector<Real>         vals(np*nc);
+        Long*         idp  = ids.data();
+        int*          cpup = cpus.data();
+        ParticleReal* posp = pos.data();
+        Real*         valp = vals.data();
+
+        int tile = 0;
+        for (TParIter pti(*NSPC, lev); pti.isValid(); ++pti, ++tile)
+        {
+            const auto* pstruct = pti.GetArrayOfStructs()().dataPtr();
+            auto const& arr     = (nc > 0) ? mf.const_array(pti) : Array4<Real const>{};
+            const Long  off     = tile_offset[tile];
+
+            amrex::ParallelFor(pti.numParticles(), [=]
+            AMREX_GPU_DEVICE (int ip) noexcept
+            {
+                const auto& p = pstruct[ip];
+                const Long  q = off + ip;
+
+                idp[q]  = p.id();
+                cpup[q] = p.cpu();
+
+                //
+                // Cloud-in-cell interpolation of the cell-centered data
+                //
+                int  i0[3] = {0, 0, 0};
+                Real w[3]  = {0.0, 0.0, 0.0};
+                for (int d = 0; d < AMREX_SPACEDIM; ++d)
+                {
+                    posp[q*AMREX_SPACEDIM+d] = p.pos(d);
+                    const Real l = (p.pos(d) - plo[d])*dxi[d] - Real(0.5);
+                    i0[d] = static_cast<int>(amrex::Math::floor(l));
+                    w[d]  = l - i0[d];
+                }
+
+                for (int n = 0; n < nc; ++n)
+                {
+                    Real v = 0.0;
+                    for (int kk = 0; kk < (AMREX_SPACEDIM == 3 ? 2 : 1); ++kk) {
+                    for (int jj = 0; jj < 2; ++jj) {
+                    for (int ii = 0; ii < 2; ++ii) {
+                        Real wt = (ii ? w[0] : Real(1.0)-w[0])
+                                * (jj ? w[1] : Real(1.0)-w[1]);
+#if (AMREX_SPACEDIM == 3)
+                        wt *= (kk ? w[2] : Real(1.0)-w[2]);
+#endif
+                        v += wt*arr(i0[0]+ii, i0[1]+jj, i0[2]+kk, n);
+                    }}}
+                    valp[q*nc+n] = v;
+                }
+            });
+        }
+
+        std::vector<Long>         h_ids(np);
+        std::vector<int>          h_cpus(np);
+        std::vector<ParticleReal> h_pos(np*AMREX_SPACEDIM);
+        std::vector<Real>         h_vals(np*nc);
+        Gpu::copyAsync(Gpu::deviceToHost, ids.begin(),  ids.end(),  h_ids.begin());
+        Gpu::copyAsync(Gpu::deviceToHost, cpus.begin(), cpus.end(), h_cpus.begin());
+        Gpu::copyAsync(Gpu::deviceToHost, pos.begin(),  pos.end(),  h_pos.begin());
+        Gpu::copyAsync(Gpu::deviceToHost, vals.begin(), vals.end(), h_vals.begin());
+        Gpu::streamSynchronize();
+
+        if (!timestamp_files)
+        {
+            timestamp_files = std::make_unique<TimestampFiles>();
+            timestamp_files->buffer.resize(8*1024*1024);
+            timestamp_files->bin.rdbuf()->pubsetbuf(timestamp_files->buffer.data(),
+                                                   timestamp_files->buffer.size());
+
+            const std::string name = amrex::Concatenate(basename + "_bin.", ParallelDescriptor::MyProc(), 5);
+            const auto mode = timestamp_append ? std::ios::app : std::ios::trunc;
+
+            timestamp_files->bin.open(name, std::ios::out|std::ios::binary|mode);
+            if (!timestamp_files->bin.good()) amrex::FileOpenFailed(name);
+
+            timestamp_files->idx.open(name + ".idx", std::ios::out|mode);
+            if (!timestamp_files->idx.good()) amrex::FileOpenFailed(name + ".idx");
+
+            if (!timestamp_append)
+            {
+                timestamp_files->idx << "# time level nparticles ncomp offset\n"
+                                     << "# sizeof Long int ParticleReal Real: "
+                                     << sizeof(Long) << ' ' << sizeof(int) << ' '
+                                     << sizeof(ParticleReal) << ' ' << sizeof(Real) << '\n';
+            }
+            timestamp_files->idx << std::setprecision(17);
+
+            // Flush and close the files before exit
+            amrex::ExecOnFinalize([] () { timestamp_files.reset(); });
+        }
+
+        std::ofstream& bin = timestamp_files->bin;
+        const auto offset = static_cast<Long>(bin.tellp());
+
+        bin.write(reinterpret_cast<const char*>(h_ids.data()),  h_ids.size()*sizeof(Long));
+        bin.write(reinterpret_cast<const char*>(h_cpus.data()), h_cpus.size()*sizeof(int));
+        bin.write(reinterpret_cast<const char*>(h_pos.data()),  h_pos.size()*sizeof(ParticleReal));
+        bin.write(reinterpret_cast<const char*>(h_vals.data()), h_vals.size()*sizeof(Real));
+        if (!bin.good()) amrex::Abort("write_binary_timestamp: failed writing trajectory file");
+
+        timestamp_files->idx << time << ' ' << lev << ' ' << np << ' ' << nc << ' ' << offset << '\n';
+    }
+}
 #endif
 
 NavierStokesBase::NavierStokesBase ()
@@ -430,10 +701,33 @@ NavierStokesBase::Initialize ()
 
     ParmParse pp("ns");
 
-    pp.query("dump_plane",dump_plane);
-
     pp.query("benchmarking",benchmarking);
 
+    pp.query("async_checkpoint",async_checkpoint);
+    if (async_checkpoint && !AsyncOut::UseAsyncOut()) {
+        amrex::Abort("ns.async_checkpoint requires amrex.async_out = 1");
+    }
+
+    std::string plot_precision("double");
+    pp.query("plot_precision",plot_precision);
+    if (plot_precision == "float") {
+        plot_float = true;
+    } else if (plot_precision != "double") {
+        amrex::Abort("ns.plot_precision must be double or float");
+    }
+    //
+    // Asynchronous output writes the data in its native precision.
+    //
+    if (plot_float && AsyncOut::UseAsyncOut()) {
+        amrex::Abort("ns.plot_precision = float is not available with amrex.async_out = 1");
+    }
+    pp.queryarr("plot_reduced_vars",plot_reduced_vars);
+    pp.query("plot_mantissa_bits",plot_mantissa_bits);
+    if (plot_mantissa_bits < 1 || plot_mantissa_bits > 52) {
+        amrex::Abort("ns.plot_mantissa_bits must be between 1 and 52");
+    }
+    pp.query("plot_abs_tol",plot_abs_tol);
+
     pp.query("v",verbose);
 
     //
@@ -449,7 +743,22 @@ NavierStokesBase::Initialize ()
     pp.query("init_dt", init_dt);
     pp.query("stop_when_steady",stop_when_steady);
     pp.query("steady_tol",steady_tol);
+    pp.query("steady_norm",steady_norm);
+    pp.query("steady_per_component",steady_per_component);
+    if (steady_norm != "speed" && steady_norm != "linf" && steady_norm != "l2") {
+        amrex::Abort("ns.steady_norm must be speed, linf or l2");
+    }
+    if (steady_norm == "speed" && steady_per_component) {
+        amrex::Abort("ns.steady_per_component requires ns.steady_norm = linf or l2");
+    }
     pp.query("sum_interval",sum_interval);
+    pp.query("spectrum_interval",spectrum_interval);
+    pp.query("spectrum_file",spectrum_file);
+#if (AMREX_SPACEDIM != 3) || !defined(AMREX_USE_FFT)
+    if (spectrum_interval > 0) {
+        amrex::Abort("ns.spectrum_interval requires a 3D build with USE_FFT = TRUE");
+    }
+#endif
     pp.query("gravity",gravity);
     //
     // Get run options.
@@ -478,11 +787,18 @@ NavierStokesBase::Initialize ()
     pp.query("visc_abs_tol",visc_abs_tol);
 
     pp.query("getForceVerbose",          getForceVerbose  );
+    pp.query("fused_velocity_update",    fused_velocity_update  );
+#ifdef AMREX_USE_EB
+    if (fused_velocity_update) {
+        amrex::Abort("NavierStokesBase::Initialize(): ns.fused_velocity_update is only available for non-EB builds");
+    }
+#endif
     pp.query("do_LES",                   do_LES  );
     pp.query("getLESVerbose",            getLESVerbose  );
     pp.query("LES_model",                LES_model  );
     pp.query("smago_Cs_cst",             smago_Cs_cst  );
     pp.query("sigma_Cs_cst",             sigma_Cs_cst  );
+    pp.query("wale_Cw_cst",              wale_Cw_cst  );
 
     pp.query("avg_interval",             avg_interval  );
     pp.query("compute_fluctuations",     compute_fluctuations  );
@@ -852,15 +1168,84 @@ NavierStokesBase::calc_dsdt (Real      /*time*/,
     }
 }
 
+void
+NavierStokesBase::checkPointPre (const std::string& dir,
+                                 std::ostream&      os)
+{
+    AmrLevel::checkPointPre(dir, os);
+
+    //
+    // Don't start a checkpoint while the previous one is still being written.
+    //
+    if (level == 0 && checkpoint_done.valid())
+    {
+        const Real strt_time = ParallelDescriptor::second();
+        checkpoint_done.wait();
+        checkpoint_done = std::future<void>();
+        if (verbose)
+        {
+            Real run_time = ParallelDescriptor::second() - strt_time;
+            ParallelDescriptor::ReduceRealMax(run_time,ParallelDescriptor::IOProcessorNumber());
+            amrex::Print() << "NavierStokesBase: waited " << run_time
+                           << " s for the previous checkpoint to finish\n";
+        }
+    }
+}
+
+void
+NavierStokesBase::checkPointPost (const std::string& dir,
+                                  std::ostream&      os)
+{
+    AmrLevel::checkPointPost(dir, os);
+
+    //
+    // The asynchronous writes are done in submission order, so this marks
+    // the end of the checkpoint once every level has queued its data.
+    //
+    if (async_checkpoint && level == parent->finestLevel())
+    {
+        auto done = std::make_shared<std::promise<void>>();
+        checkpoint_done = done->get_future();
+        AsyncOut::Submit([done] () { done->set_value(); });
+    }
+}
+
 void
 NavierStokesBase::checkPoint (const std::string& dir,
                               std::ostream&      os,
                               VisMF::How         how,
                               bool               dump_old)
 {
+    //
+    // With amrex.async_out the state and particle data are copied into
+    // staging buffers and written by the asynchronous output thread.
+    //
     AmrLevel::checkPoint(dir, os, how, dump_old);
 
-    if (avg_interval > 0)
+    if (avg_interval > 0 && async_checkpoint)
+    {
+        if (ParallelDescriptor::IOProcessor())
+        {
+            const std::string TAFileName(dir + "/TimeAverage");
+            const Real ta       = NavierStokesBase::time_avg[level];
+            const Real ta_fluct = NavierStokesBase::time_avg_fluct[level];
+
+            AsyncOut::Submit([TAFileName, ta, ta_fluct] ()
+            {
+                std::ofstream TImeAverageFile(TAFileName.c_str(), std::ofstream::out |
+                                              std::ofstream::trunc |
+                                              std::ofstream::binary);
+                if( !TImeAverageFile.good()) {
+                    amrex::FileOpenFailed(TAFileName);
+                }
+                TImeAverageFile.precision(17);
+                TImeAverageFile << "Writing time_average to checkpoint\n";
+                TImeAverageFile << ta << "\n";
+                TImeAverageFile << ta_fluct << "\n";
+            });
+        }
+    }
+    else if (avg_interval > 0)
     {
         VisMF::IO_Buffer io_buffer(VisMF::IO_Buffer_Size);
 
@@ -1349,6 +1734,17 @@ NavierStokesBase::errorEst (TagBoxArray& tb,
 //
 // Estimate the maximum allowable timestep at a cell center.
 //
+//
+// No bound on the forcing is known in general, so estTimeStep evaluates
+// getForce. A forcing with a cheap bound can override this.
+//
+bool
+NavierStokesBase::getForceBound (Real          /*time*/,
+                                 Vector<Real>& /*fbound*/)
+{
+    return false;
+}
+
 Real
 NavierStokesBase::estTimeStep ()
 {
@@ -1375,75 +1771,91 @@ NavierStokesBase::estTimeStep ()
     Real        estdt         = 1.0e+20;
 
     MultiFab&   S_new         = get_new_data(State_Type);
+    MultiFab&   Gp            = get_new_data(Gradp_Type);
+    const Real  cur_time      = state[State_Type].curTime();
 
-    Vector<Real> u_max(AMREX_SPACEDIM);
-    Vector<Real> f_max(AMREX_SPACEDIM);
-
-    MultiFab& Gp = get_new_data(Gradp_Type);
-
     //
-    // Find local max of velocity
+    // Forcing terms: in this case this means external forces and grad(p).
+    // Viscous terms not included since Crack-Nicholson is unconditionally stable
+    // so no need to account for explicit part of viscous term.
+    //
+    // If the forcing supplies a bound on |F|/rho, use it instead of evaluating
+    // getForce on every cell; grad(p) is still taken pointwise.
     //
-    u_max = S_new.norm0({AMREX_D_DECL(0,1,2)},0,true,true);
+    Vector<Real> f_bound(AMREX_SPACEDIM,0.0);
+    const bool have_fbound = getForceBound(cur_time,f_bound);
+    GpuArray<Real,AMREX_SPACEDIM> fb;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        fb[idim] = have_fbound ? std::abs(f_bound[idim]) : 0.0;
+    }
 
     //
-    // Compute forcing terms: in this case this means external forces and grad(p)
-    // Viscous terms not included since Crack-Nicholson is unconditionally stable
-    // so no need to account for explicit part of viscous term
+    // Find local max of |u|/dx and |f|/dx in a single pass over the data.
+    // Only components above small contribute, as with separate per-direction
+    // maxima of u and f.
     //
-    MultiFab tforces(grids,dmap,AMREX_SPACEDIM,0,MFInfo(),Factory());
+    const auto dxinv = geom.InvCellSizeArray();
+
+    ReduceOps<ReduceOpMax,ReduceOpMax> reduce_op;
+    ReduceData<Real,Real> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
 
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
     for (MFIter mfi(S_new,TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
-       const auto& bx          = mfi.tilebox();
-       const auto  cur_time    = state[State_Type].curTime();
-       auto& tforces_fab       = tforces[mfi];
-
-       if (getForceVerbose) {
-           amrex::Print() << "---" << '\n'
-                          << "H - est Time Step:" << '\n'
-                          << "Calling getForce..." << '\n';
+       const auto& bx    = mfi.tilebox();
+       const auto& vel   = S_new.const_array(mfi,Xvel);
+       const auto& rho   = S_new.const_array(mfi,Density);
+       const auto& gradp = Gp.const_array(mfi);
+
+       FArrayBox tforces;
+       Array4<Real const> force;
+       if (!have_fbound)
+       {
+           if (getForceVerbose) {
+               amrex::Print() << "---" << '\n'
+                              << "H - est Time Step:" << '\n'
+                              << "Calling getForce..." << '\n';
+           }
+           tforces.resize(bx,AMREX_SPACEDIM,The_Async_Arena());
+           getForce(tforces,bx,0,AMREX_SPACEDIM,cur_time,S_new[mfi],S_new[mfi],Density,mfi);
+           force = tforces.const_array();
        }
-       getForce(tforces_fab,bx,0,AMREX_SPACEDIM,cur_time,S_new[mfi],S_new[mfi],Density,mfi);
 
-       const auto& rho   = S_new.array(mfi,Density);
-       const auto& gradp = Gp.array(mfi);
-       const auto& force = tforces.array(mfi);
-       amrex::ParallelFor(bx, [rho, gradp, force]
-       AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+       reduce_op.eval(bx, reduce_data, [vel, rho, gradp, force, fb, have_fbound, dxinv, small]
+       AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
        {
           Real rho_inv = 1.0/rho(i,j,k);
+          Real u_dx = 0.0;
+          Real f_dx = 0.0;
           for (int n = 0; n < AMREX_SPACEDIM; n++) {
-             force(i,j,k,n) -= gradp(i,j,k,n);
-             force(i,j,k,n) *= rho_inv;
+             Real u = std::abs(vel(i,j,k,n));
+             Real f = have_fbound ? fb[n] + std::abs(gradp(i,j,k,n))*rho_inv
+                                  : std::abs(force(i,j,k,n) - gradp(i,j,k,n))*rho_inv;
+             if (u > small) u_dx = amrex::max(u_dx, u*dxinv[n]);
+             if (f > small) f_dx = amrex::max(f_dx, f*dxinv[n]);
           }
+          return {u_dx, f_dx};
        });
     }
 
-    //
-    // Find local max of tforces
-    //
-    f_max = tforces.norm0({AMREX_D_DECL(0,1,2)},0,true,true);
-
     //
     // Compute local estdt
     //
-    const Real* dx = geom.CellSize();
+    ReduceTuple hv = reduce_data.value();
+    const Real u_dx_max = amrex::get<0>(hv);
+    const Real f_dx_max = amrex::get<1>(hv);
 
-    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+    if (u_dx_max > 0.0)
     {
-        if (u_max[idim] > small)
-        {
-            estdt = std::min(estdt, dx[idim]/u_max[idim]);
-        }
+        estdt = std::min(estdt, 1.0/u_dx_max);
+    }
 
-        if (f_max[idim] > small)
-        {
-            estdt = std::min(estdt, std::sqrt(2.0*dx[idim]/f_max[idim]));
-        }
+    if (f_dx_max > 0.0)
+    {
+        estdt = std::min(estdt, std::sqrt(2.0/f_dx_max));
     }
 
     //
@@ -1947,18 +2359,10 @@ NavierStokesBase::level_sync (int crse_iteration)
         crsr_sync_ptr = &(getLevel(level).getSyncReg());
     }
     //
-    // Get boundary conditions.
+    // Get boundary conditions. SyncInterp only needs the domain BCs of the
+    // velocity, so nothing is built per box.
     //
-    const auto N = int(grids.size());
-
-    Vector<int*>         sync_bc(N);
-    Vector< Vector<int> > sync_bc_array(N);
-
-    for (int i = 0; i < N; i++)
-    {
-        sync_bc_array[i] = getBCArray(State_Type,i,Xvel,AMREX_SPACEDIM);
-        sync_bc[i] = sync_bc_array[i].dataPtr();
-    }
+    const BCRec* sync_bc = &(desc_lst[State_Type].getBCs()[Xvel]);
 
     //
     // Multilevel sync projection.
@@ -1991,7 +2395,7 @@ NavierStokesBase::level_sync (int crse_iteration)
     // Interpolate Vsync to fine grid correction in Vcorr.
     //
     SyncInterp(Vsync, level, V_corr, level+1, ratio,
-               0, 0, AMREX_SPACEDIM, 0 , dt, sync_bc.dataPtr());
+               0, 0, AMREX_SPACEDIM, 0 , dt, sync_bc);
     //
     // The multilevel projection.  This computes the projection and
     // adds in its contribution to levels (level) and (level+1).
@@ -2007,22 +2411,8 @@ NavierStokesBase::level_sync (int crse_iteration)
     //
     // Correct pressure and velocities after the projection.
     //
-    const auto Nf = int(finegrids.size());
-
     ratio = IntVect::TheUnitVector();
 
-    Vector<int*>         fine_sync_bc(Nf);
-    Vector< Vector<int> > fine_sync_bc_array(Nf);
-
-    for (int i = 0; i < Nf; i++)
-    {
-      fine_sync_bc_array[i] = getLevel(level+1).getBCArray(State_Type,
-                                                           i,
-                                                           Xvel,
-                                                           AMREX_SPACEDIM);
-      fine_sync_bc[i] = fine_sync_bc_array[i].dataPtr();
-    }
-
     for (int lev = level+2; lev <= finest_level; lev++)
     {
       ratio                 *= parent->refRatio(lev-1);
@@ -2032,7 +2422,7 @@ NavierStokesBase::level_sync (int crse_iteration)
       MultiFab&     U_new    = flev.get_new_data(State_Type);
 
       SyncInterp(V_corr, level+1, U_new, lev, ratio,
-                 0, 0, AMREX_SPACEDIM, 1 , dt, fine_sync_bc.dataPtr());
+                 0, 0, AMREX_SPACEDIM, 1 , dt, sync_bc);
       SyncProjInterp(phi, level+1, P_new, P_old, lev, ratio);
 
       flev.computeGradP(flev.state[Gradp_Type].prevTime());
@@ -2237,50 +2627,79 @@ NavierStokesBase::steadyState()
     MultiFab&   u_new = get_new_data(State_Type);
 
         //
-        // Estimate the maximum change in velocity magnitude since previous
-        // iteration
+        // Measure the change in velocity since the previous iteration. All
+        // the norms are gathered in a single pass: the maximum change in
+        // velocity magnitude, and per component the maximum and the sum of
+        // squares of the change. Components beyond AMREX_SPACEDIM stay zero.
         //
-    Real max_change = 0.0;
-
-    ReduceOps<ReduceOpMax> reduce_op;
-    ReduceData<Real> reduce_data(reduce_op);
+    ReduceOps<ReduceOpMax,
+              ReduceOpMax, ReduceOpMax, ReduceOpMax,
+              ReduceOpSum, ReduceOpSum, ReduceOpSum> reduce_op;
+    ReduceData<Real, Real, Real, Real, Real, Real, Real> reduce_data(reduce_op);
     using ReduceTuple = typename decltype(reduce_data)::Type;
 
-    // Do not OpenMP-fy this loop for now
-    // Unclear how to keep OpenMP and GPU implementation
-    // from messing with each other
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
     for (MFIter mfi(u_old,TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
         const auto& bx   = mfi.tilebox();
-        const auto& uold = u_old[mfi].array();
-        const auto& unew = u_new[mfi].array();
+        const auto& uold = u_old.const_array(mfi);
+        const auto& unew = u_new.const_array(mfi);
 
         reduce_op.eval(bx, reduce_data, [uold, unew]
         AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
         {
             Real uold_mag = 0.0;
             Real unew_mag = 0.0;
+            Real du[3] = {0.0, 0.0, 0.0};
             for (int d = 0; d < AMREX_SPACEDIM; ++d)
             {
                 uold_mag += uold(i,j,k,d)*uold(i,j,k,d);
                 unew_mag += unew(i,j,k,d)*unew(i,j,k,d);
+                du[d]     = unew(i,j,k,d) - uold(i,j,k,d);
             }
 
             uold_mag = std::sqrt(uold_mag);
             unew_mag = std::sqrt(unew_mag);
 
-            return std::abs(unew_mag-uold_mag);
+            return {std::abs(unew_mag-uold_mag),
+                    std::abs(du[0]), std::abs(du[1]), std::abs(du[2]),
+                    du[0]*du[0], du[1]*du[1], du[2]*du[2]};
         });
+    }
+
+    ReduceTuple hv = reduce_data.value();
+    Real max_vals[4] = {amrex::get<0>(hv), amrex::get<1>(hv), amrex::get<2>(hv), amrex::get<3>(hv)};
+    Real sum_vals[3] = {amrex::get<4>(hv), amrex::get<5>(hv), amrex::get<6>(hv)};
+    ParallelDescriptor::ReduceRealMax(max_vals, 4);
+    ParallelDescriptor::ReduceRealSum(sum_vals, 3);
 
-        max_change = std::max(amrex::get<0>(reduce_data.value()),
-                              max_change);
+    //
+    // The norm of the change, per velocity component if requested.
+    // The L2 norm is the root mean square over the cells of the level.
+    //
+    const auto npts = static_cast<Real>(grids.numPts());
+    Vector<Real> change(AMREX_SPACEDIM, 0.0);
+    for (int d = 0; d < AMREX_SPACEDIM; ++d)
+    {
+        change[d] = (steady_norm == "l2") ? std::sqrt(sum_vals[d]/npts) : max_vals[d+1];
     }
 
-    ParallelDescriptor::ReduceRealMax(max_change);
+    Real max_change = 0.0;
+    if (steady_norm == "speed") {
+        max_change = max_vals[0];
+    } else if (steady_norm == "linf" || steady_per_component) {
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            max_change = std::max(max_change, change[d]);
+        }
+    } else {
+        max_change = std::sqrt((AMREX_D_TERM(sum_vals[0], + sum_vals[1], + sum_vals[2]))/npts);
+    }
 
         //
-        // System is classified as steady if the maximum change is smaller than
-        // prescribed tolerance
+        // System is classified as steady if the change is smaller than
+        // prescribed tolerance (in every component if done per component)
         //
     bool steady = max_change < steady_tol;
 
@@ -2289,6 +2708,15 @@ NavierStokesBase::steadyState()
         amrex::Print() << "steadyState :: \n" << "LEV = " << level
                        << " MAX_CHANGE = " << max_change << std::endl;
 
+        if (steady_per_component)
+        {
+            amrex::Print() << "CHANGE (" << steady_norm << ") =";
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                amrex::Print() << " " << change[d];
+            }
+            amrex::Print() << std::endl;
+        }
+
         if (steady)
         {
             amrex::Print()
@@ -2445,6 +2873,8 @@ void
 NavierStokesBase::post_regrid (int lbase,
                                int /*new_finest*/)
 {
+    diffusion->invalidateOperatorCache();
+
 #ifdef AMREX_PARTICLES
     if (NSPC && level == lbase)
     {
@@ -2461,9 +2891,19 @@ NavierStokesBase::post_regrid (int lbase,
 void
 NavierStokesBase::post_restart ()
 {
+    diffusion->invalidateOperatorCache();
+
     make_rho_prev_time();
     make_rho_curr_time();
 
+    //
+    // Set up the samplers while the step count is still the checkpoint's, so
+    // that they drop the samples written after it.
+    //
+    if (level == 0) {
+        NSSampler::Initialize(*parent);
+    }
+
   if (avg_interval > 0){
 
     const int   finest_level = parent->finestLevel();
@@ -2591,40 +3031,19 @@ NavierStokesBase::post_timestep (int crse_iteration)
         sum_integrated_quantities();
     }
 
-    if (level > 0) incrPAvg();
-
-    if (level == 0 && dump_plane >= 0)
+    if (level==0 && spectrum_interval>0 && (parent->levelSteps(0)%spectrum_interval == 0))
     {
-        Box bx = geom.Domain();
-
-        AMREX_ASSERT(bx.bigEnd(AMREX_SPACEDIM-1) >= dump_plane);
-
-        bx.setSmall(AMREX_SPACEDIM-1, dump_plane);
-        bx.setBig  (AMREX_SPACEDIM-1, dump_plane);
-
-        BoxArray ba(bx);
-        DistributionMapping dm{ba};
-
-        MultiFab mf(ba, dm, AMREX_SPACEDIM, 0, MFInfo(), Factory());
-
-        mf.ParallelCopy(get_new_data(State_Type), Xvel, 0, AMREX_SPACEDIM);
-
-        if (ParallelDescriptor::MyProc() == mf.DistributionMap()[0])
-        {
-            char buf[64];
-            sprintf(buf, "%14.12e", state[State_Type].curTime());
-
-            std::string name(dump_plane_name);
-            name += buf;
-            name += ".fab";
+        kinetic_energy_spectrum();
+    }
 
-            std::ofstream ofs;
-            ofs.open(name.c_str(),std::ios::out|std::ios::trunc|std::ios::binary);
-            if (!ofs.good())
-                amrex::FileOpenFailed(name);
+    if (level > 0) incrPAvg();
 
-            mf[0].writeOn(ofs);
-        }
+    //
+    // In-situ sampling on planes, lines and probes (ns.samplers).
+    //
+    if (level == 0)
+    {
+        NSSampler::SampleAll(*parent, parent->levelSteps(0), state[State_Type].curTime());
     }
 
     if (avg_interval > 0)
@@ -3024,6 +3443,8 @@ NavierStokesBase::sync_cleanup (MultiFab*& DeltaSsync)
 
 //
 // Helper function for NavierStokesBase::SyncInterp().
+// Faces of box lying outside the domain get the domain BC of the quantity,
+// all others are interior.
 //
 static
 void
@@ -3032,28 +3453,15 @@ set_bcrec_new (Vector<BCRec>  &bcrec,
                int             src_comp,
                const Box&      box,
                const Box&      domain,
-               const BoxArray& cgrids,
-               int**           bc_orig_qty)
+               const BCRec*    bc_orig_qty)
 
 {
    for (int n = 0; n < ncomp; n++) {
+      const BCRec& bc = bc_orig_qty[src_comp+n];
       for (int dir = 0; dir < AMREX_SPACEDIM; dir++)
       {
-         int bc_index = (src_comp+n)*(2*AMREX_SPACEDIM) + dir;
-         bcrec[n].setLo(dir,BCType::int_dir);
-         bcrec[n].setHi(dir,BCType::int_dir);
-         if ( ( box.smallEnd(dir) < domain.smallEnd(dir) ) ||
-              ( box.bigEnd(dir)   > domain.bigEnd(dir) ) ) {
-            for (int crse = 0; crse < cgrids.size(); crse++) {
-               const Box& crsebx = cgrids[crse];
-               if ( ( box.smallEnd(dir) < domain.smallEnd(dir) ) && ( crsebx.smallEnd(dir) == domain.smallEnd(dir) ) ) {
-                  bcrec[n].setLo(dir,bc_orig_qty[crse][bc_index]);
-               }
-               if ( ( box.bigEnd(dir) > domain.bigEnd(dir) ) && ( crsebx.bigEnd(dir) == domain.bigEnd(dir) ) ) {
-                  bcrec[n].setHi(dir,bc_orig_qty[crse][bc_index+AMREX_SPACEDIM]);
-               }
-            }
-         }
+         bcrec[n].setLo(dir, ( box.smallEnd(dir) < domain.smallEnd(dir) ) ? bc.lo(dir) : int(BCType::int_dir));
+         bcrec[n].setHi(dir, ( box.bigEnd(dir)   > domain.bigEnd(dir)   ) ? bc.hi(dir) : int(BCType::int_dir));
       }
    }
 }
@@ -3065,7 +3473,8 @@ set_bcrec_new (Vector<BCRec>  &bcrec,
 // This routine interpolates the num_comp components of CrseSync
 // (starting at src_comp) and either increments or puts the result into
 // the num_comp components of FineSync (starting at dest_comp)
-// The components of bc_orig_qty corespond to the quantities of CrseSync.
+// bc_orig_qty holds the domain BCs of the quantities of CrseSync
+// (e.g. the State_Type descriptor BCs starting at the first synced component).
 //
 void
 NavierStokesBase::SyncInterp (MultiFab&      CrseSync,
@@ -3078,7 +3487,7 @@ NavierStokesBase::SyncInterp (MultiFab&      CrseSync,
                               int            num_comp,
                               int            increment,
                               Real           dt_clev,
-                              int**          bc_orig_qty,
+                              const BCRec*   bc_orig_qty,
                               SyncInterpType which_interp,
                               int            state_comp)
 {
@@ -3111,7 +3520,6 @@ NavierStokesBase::SyncInterp (MultiFab&      CrseSync,
     const BoxArray& fgrids           = fine_level.boxArray();
     const DistributionMapping& fdmap = fine_level.DistributionMap();
     const Geometry& fgeom            = parent->Geom(f_lev);
-    const BoxArray& cgrids           = getLevel(c_lev).boxArray();
     const Geometry& cgeom            = parent->Geom(c_lev);
     Box             cdomain          = amrex::coarsen(fgeom.Domain(),ratio);
     const auto      N                = int(fgrids.size());
@@ -3154,7 +3562,7 @@ NavierStokesBase::SyncInterp (MultiFab&      CrseSync,
        FArrayBox& data = cdataMF[mfi];
 
        Vector<BCRec> bx_bcrec(num_comp);
-       set_bcrec_new(bx_bcrec,num_comp,src_comp,bx,cdomain,cgrids,bc_orig_qty);
+       set_bcrec_new(bx_bcrec,num_comp,src_comp,bx,cdomain,bc_orig_qty);
        gpu_bndry_func(bx,data,0,num_comp,cgeom,0.0,bx_bcrec,0,0);
     }
 
@@ -3195,7 +3603,7 @@ NavierStokesBase::SyncInterp (MultiFab&      CrseSync,
          // Set the boundary condition array for interpolation.
          //
          Vector<BCRec> bx_bcrec(num_comp);
-         set_bcrec_new(bx_bcrec,num_comp,src_comp,cbx,cdomain,cgrids,bc_orig_qty);
+         set_bcrec_new(bx_bcrec,num_comp,src_comp,cbx,cdomain,bc_orig_qty);
 
          //ScaleCrseSyncInterp(cdata, c_lev, num_comp);
 
@@ -3351,6 +3759,93 @@ NavierStokesBase::thePlotFileType () const
     return the_plot_file_type;
 }
 
+void
+NavierStokesBase::writePlotFile (const std::string& dir,
+                                 std::ostream&      os,
+                                 VisMF::How         how)
+{
+    if (!plot_float && plot_reduced_vars.empty())
+    {
+        AmrLevel::writePlotFile(dir,os,how);
+        return;
+    }
+
+    //
+    // AmrLevel::writePlotFile copies the plotted state components from the new
+    // time data, so swap in copies of the state types with reduced precision
+    // plot variables, rounded, for the duration of the write. Derived plot
+    // variables are computed from the full precision state, which
+    // NavierStokes::derive swaps back in, and only their output is rounded
+    // (see reducePlotPrecision).
+    //
+    AMREX_ASSERT(plot_state_swap.empty());
+    for (int typ = 0; typ < desc_lst.size(); typ++)
+    {
+        if (desc_lst[typ].getType() != IndexType::TheCellType()) continue;
+
+        Vector<int> comps;
+        for (int comp = 0; comp < desc_lst[typ].nComp(); comp++)
+        {
+            if (parent->isStatePlotVar(desc_lst[typ].name(comp)) &&
+                isReducedPlotVar(desc_lst[typ].name(comp)))
+            {
+                comps.push_back(comp);
+            }
+        }
+        if (comps.empty()) continue;
+
+        MultiFab& S = state[typ].newData();
+        MultiFab  R(S.boxArray(), S.DistributionMap(), S.nComp(), S.nGrow(), MFInfo(), Factory());
+        MultiFab::Copy(R, S, 0, 0, S.nComp(), S.nGrow());
+        for (int comp : comps) {
+            reduce_precision(R, comp);
+        }
+        std::swap(S, R);
+        plot_state_swap.emplace_back(typ, std::move(R));
+    }
+
+    const FABio::Format prev_format = FArrayBox::getFormat();
+    if (plot_float) {
+        FArrayBox::setFormat(FABio::FAB_NATIVE_32);
+    }
+    writing_reduced_plot = !plot_reduced_vars.empty();
+
+    AmrLevel::writePlotFile(dir,os,how);
+
+    writing_reduced_plot = false;
+    FArrayBox::setFormat(prev_format);
+
+    swapPlotState();
+    plot_state_swap.clear();
+}
+
+void
+NavierStokesBase::swapPlotState ()
+{
+    for (auto& tm : plot_state_swap) {
+        std::swap(state[tm.first].newData(), tm.second);
+    }
+}
+
+bool
+NavierStokesBase::isReducedPlotVar (const std::string& name)
+{
+    for (auto const& v : plot_reduced_vars) {
+        if (v == name || v == "ALL" || v == "all") return true;
+    }
+    return false;
+}
+
+void
+NavierStokesBase::reducePlotPrecision (const std::string& name,
+                                       MultiFab&          mf,
+                                       int                comp)
+{
+    if (writing_reduced_plot && isReducedPlotVar(name)) {
+        reduce_precision(mf, comp);
+    }
+}
+
 //
 // This routine advects the velocities
 //
@@ -3530,102 +4025,111 @@ NavierStokesBase::velocity_advection_update (Real dt)
     MultiFab&  Gp    = get_old_data(Gradp_Type);
     MultiFab& Rh = get_rho_half_time();
 
-    MultiFab Vel(grids, dmap, AMREX_SPACEDIM, 0, MFInfo(), Factory());
-    //
-    // Average mac face velocity to cell-centers for use in generating external
-    // forcing term in getForce()
-    // NOTE that default getForce() does not use Vel or Scal, user must supply the
-    // forcing function for that case.
-    //
+#ifndef AMREX_USE_EB
+    if (fused_velocity_update)
+    {
+        velocity_advection_update_fused(dt);
+    }
+    else
+#endif
+    {
+        MultiFab Vel(grids, dmap, AMREX_SPACEDIM, 0, MFInfo(), Factory());
+        //
+        // Average mac face velocity to cell-centers for use in generating external
+        // forcing term in getForce()
+        // NOTE that default getForce() does not use Vel or Scal, user must supply the
+        // forcing function for that case.
+        //
 #ifdef AMREX_USE_EB
-    // This isn't quite right because it's face-centers to cell-centers
-    // what's really wanted is face-centroid to cell-centroid
-    EB_average_face_to_cellcenter(Vel, 0, Array<MultiFab const*,AMREX_SPACEDIM>{{AMREX_D_DECL(&u_mac[0],&u_mac[1],&u_mac[2])}});
+        // This isn't quite right because it's face-centers to cell-centers
+        // what's really wanted is face-centroid to cell-centroid
+        EB_average_face_to_cellcenter(Vel, 0, Array<MultiFab const*,AMREX_SPACEDIM>{{AMREX_D_DECL(&u_mac[0],&u_mac[1],&u_mac[2])}});
 #else
-    average_face_to_cellcenter(Vel, 0, Array<MultiFab const*,AMREX_SPACEDIM>{{AMREX_D_DECL(&u_mac[0],&u_mac[1],&u_mac[2])}});
+        average_face_to_cellcenter(Vel, 0, Array<MultiFab const*,AMREX_SPACEDIM>{{AMREX_D_DECL(&u_mac[0],&u_mac[1],&u_mac[2])}});
 #endif
 
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-{
-    FArrayBox  tforces, ScalFAB;
+        {
+            FArrayBox  tforces, ScalFAB;
 
-    for (MFIter mfi(Rh,TilingIfNotGPU()); mfi.isValid(); ++mfi)
-    {
-        const Box& bx = mfi.tilebox();
-        FArrayBox& VelFAB = Vel[mfi];
-        ScalFAB.resize(bx,NUM_SCALARS);
-        Elixir scal_i = ScalFAB.elixir();
+            for (MFIter mfi(Rh,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            {
+                const Box& bx = mfi.tilebox();
+                FArrayBox& VelFAB = Vel[mfi];
+                ScalFAB.resize(bx,NUM_SCALARS);
+                Elixir scal_i = ScalFAB.elixir();
 
-        //
-        // Need to do some funky half-time stuff.
-        //
-        if (getForceVerbose)
-           amrex::Print() << "---" << '\n' << "F - velocity advection update (half time):" << '\n';
-        //
-        // Average the new and old time to get Crank-Nicholson half time approximation.
-        // Scalars always get updated before velocity (see NavierStokes::advance), so
-        // this is garanteed to be good.
-        //
-        auto const& scal = ScalFAB.array();
-        auto const& scal_o = U_old.array(mfi,Density);
-        auto const& scal_n = U_new.array(mfi,Density);
-        amrex::ParallelFor(bx, NUM_SCALARS, [scal, scal_o, scal_n]
-        AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
-        {
-            scal(i,j,k,n) = 0.5 * ( scal_o(i,j,k,n) + scal_n(i,j,k,n) );
-        });
+                //
+                // Need to do some funky half-time stuff.
+                //
+                if (getForceVerbose)
+                   amrex::Print() << "---" << '\n' << "F - velocity advection update (half time):" << '\n';
+                //
+                // Average the new and old time to get Crank-Nicholson half time approximation.
+                // Scalars always get updated before velocity (see NavierStokes::advance), so
+                // this is garanteed to be good.
+                //
+                auto const& scal = ScalFAB.array();
+                auto const& scal_o = U_old.array(mfi,Density);
+                auto const& scal_n = U_new.array(mfi,Density);
+                amrex::ParallelFor(bx, NUM_SCALARS, [scal, scal_o, scal_n]
+                AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+                {
+                    scal(i,j,k,n) = 0.5 * ( scal_o(i,j,k,n) + scal_n(i,j,k,n) );
+                });
 
-        const Real half_time = 0.5*(state[State_Type].prevTime()+state[State_Type].curTime());
-        tforces.resize(bx,AMREX_SPACEDIM);
-        Elixir tf_i = tforces.elixir();
-        getForce(tforces,bx,Xvel,AMREX_SPACEDIM,half_time,VelFAB,ScalFAB,0,mfi);
+                const Real half_time = 0.5*(state[State_Type].prevTime()+state[State_Type].curTime());
+                tforces.resize(bx,AMREX_SPACEDIM);
+                Elixir tf_i = tforces.elixir();
+                getForce(tforces,bx,Xvel,AMREX_SPACEDIM,half_time,VelFAB,ScalFAB,0,mfi);
 
-        //
-        // Do following only at initial iteration--per JBB.
-        //
-        if (initial_iter && is_diffusive[Xvel]) {
-           auto const& force  = tforces.array();
-           amrex::ParallelFor(bx, AMREX_SPACEDIM, [force]
-           AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
-           {
-               force(i,j,k,n) = 0.0;
-           });
-        }
+                //
+                // Do following only at initial iteration--per JBB.
+                //
+                if (initial_iter && is_diffusive[Xvel]) {
+                   auto const& force  = tforces.array();
+                   amrex::ParallelFor(bx, AMREX_SPACEDIM, [force]
+                   AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+                   {
+                       force(i,j,k,n) = 0.0;
+                   });
+                }
 
-        // Update velocity
-        auto const& vel_old  = U_old.array(mfi);
-        auto const& vel_new  = U_new.array(mfi);
-        auto const& gradp    = Gp.array(mfi);
-        auto const& force    = tforces.array();
-        auto const& advec    = Aofs.array(mfi);
-        auto const& rho_old  = U_old.array(mfi, Density);
-        auto const& rho_new  = U_new.array(mfi, Density);
-        auto const& rho_Half = Rh.array(mfi);
-        int mom_diff = do_mom_diff;
-        amrex::ParallelFor(bx, AMREX_SPACEDIM, [vel_old,vel_new,gradp,force,advec,rho_old,rho_new,rho_Half,mom_diff,dt]
-        AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
-        {
-            Real velold = vel_old(i,j,k,n);
+                // Update velocity
+                auto const& vel_old  = U_old.array(mfi);
+                auto const& vel_new  = U_new.array(mfi);
+                auto const& gradp    = Gp.array(mfi);
+                auto const& force    = tforces.array();
+                auto const& advec    = Aofs.array(mfi);
+                auto const& rho_old  = U_old.array(mfi, Density);
+                auto const& rho_new  = U_new.array(mfi, Density);
+                auto const& rho_Half = Rh.array(mfi);
+                int mom_diff = do_mom_diff;
+                amrex::ParallelFor(bx, AMREX_SPACEDIM, [vel_old,vel_new,gradp,force,advec,rho_old,rho_new,rho_Half,mom_diff,dt]
+                AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+                {
+                    Real velold = vel_old(i,j,k,n);
 
-            if ( mom_diff ) {
-               velold *= rho_old(i,j,k);
-               vel_new(i,j,k,n) = velold - dt * advec(i,j,k,n)
-                                         + dt * force(i,j,k,n)
-                                         - dt * gradp(i,j,k,n);
+                    if ( mom_diff ) {
+                       velold *= rho_old(i,j,k);
+                       vel_new(i,j,k,n) = velold - dt * advec(i,j,k,n)
+                                                 + dt * force(i,j,k,n)
+                                                 - dt * gradp(i,j,k,n);
 
-               vel_new(i,j,k,n) /= rho_new(i,j,k);
-            }
-            else
-            {
-                vel_new(i,j,k,n) = velold - dt * advec(i,j,k,n)
-                                          + dt * force(i,j,k,n) / rho_Half(i,j,k)
-                                          - dt * gradp(i,j,k,n) / rho_Half(i,j,k);
+                       vel_new(i,j,k,n) /= rho_new(i,j,k);
+                    }
+                    else
+                    {
+                        vel_new(i,j,k,n) = velold - dt * advec(i,j,k,n)
+                                                  + dt * force(i,j,k,n) / rho_Half(i,j,k)
+                                                  - dt * gradp(i,j,k,n) / rho_Half(i,j,k);
+                    }
+                });
             }
-        });
+        }
     }
-}
 
     for (int sigma = 0; sigma < AMREX_SPACEDIM; sigma++)
     {
@@ -3654,6 +4158,54 @@ NavierStokesBase::velocity_advection_update (Real dt)
     }
 }
 
+#ifndef AMREX_USE_EB
+//
+// Velocity advection update with the default forcing evaluated in place.
+// The default getForce only needs the half-time density, so the velocity is
+// updated in one pass, without building the cell-centered velocity,
+// half-time scalars or tforces.
+//
+void
+NavierStokesBase::velocity_advection_update_fused (Real dt)
+{
+    BL_PROFILE("NavierStokesBase::velocity_advection_update_fused()");
+
+    if (!hasDefaultForce()) {
+        amrex::Abort("NavierStokesBase::velocity_advection_update_fused(): ns.fused_velocity_update requires the default getForce");
+    }
+
+    MultiFab&  U_old          = get_old_data(State_Type);
+    MultiFab&  U_new          = get_new_data(State_Type);
+    MultiFab&  Aofs           = *aofs;
+    MultiFab&  Gp             = get_old_data(Gradp_Type);
+    MultiFab&  Rh             = get_rho_half_time();
+
+    const Real grav = (initial_iter && is_diffusive[Xvel]) ? Real(0.0) : gravity;
+    const int mom_diff = do_mom_diff;
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(Rh,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        auto const& vel_old  = U_old.const_array(mfi);
+        auto const& vel_new  = U_new.array(mfi);
+        auto const& gradp    = Gp.const_array(mfi);
+        auto const& advec    = Aofs.const_array(mfi);
+        auto const& rho_old  = U_old.const_array(mfi, Density);
+        auto const& rho_new  = U_new.const_array(mfi, Density);
+        auto const& rho_Half = Rh.const_array(mfi);
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            vel_advection_update_k(i, j, k, dt, grav, mom_diff,
+                                   vel_old, vel_new, gradp, advec,
+                                   rho_old, rho_new, rho_Half);
+        });
+    }
+}
+#endif
+
 void
 NavierStokesBase::initial_velocity_diffusion_update (Real dt)
 {
@@ -3780,6 +4332,10 @@ NavierStokesBase::read_particle_params ()
 
         ppp.getarr("timestamp_indices", timestamp_indices, 0, nc);
     }
+    //
+    // Write timestamps to per-rank binary trajectory files instead of text.
+    //
+    ppp.query("timestamp_binary", timestamp_binary);
 
     ppp.query("verbose",pverbose);
     if ( ppp.countname("pverbose") > 0) {
@@ -3859,6 +4415,11 @@ NavierStokesBase::post_restart_particle ()
         {
             NSPC->WriteAsciiFile(particle_output_file);
         }
+
+        if (timestamp_binary && !timestamp_dir.empty())
+        {
+            trim_binary_timestamp(state[State_Type].curTime());
+        }
     }
 }
 
@@ -3880,11 +4441,7 @@ NavierStokesBase::post_timestep_particle (int crse_iteration)
 
         if (!timestamp_dir.empty())
         {
-            std::string basename = timestamp_dir;
-
-            if (basename[basename.length()-1] != '/') basename += '/';
-
-            basename += "Timestamp";
+            const std::string basename = timestamp_basename();
 
             static bool first = true;
             static int n, nextras;
@@ -3920,25 +4477,19 @@ NavierStokesBase::post_timestep_particle (int crse_iteration)
                 {
                     tmf.define(S_new.boxArray(), S_new.DistributionMap(), tindices.size(), ng, MFInfo(), Factory());
 
-                    if (n > 0)
+                    //
+                    // Fill only the requested components, one FillPatch per
+                    // run of consecutive state indices.
+                    //
+                    for (int i = 0; i < n; )
                     {
-                      FillPatchIterator fpi(parent->getLevel(lev), S_new,
-                                            ng, curr_time, State_Type, 0, NUM_STATE);
-                      const MultiFab& S = fpi.get_mf();
-
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-                      for (MFIter mfi(tmf,true); mfi.isValid(); ++mfi)
-                      {
-                        FArrayBox& tfab = tmf[mfi];
-                        const FArrayBox& sfab = S[mfi];
-                        const Box& box = mfi.growntilebox();
-                        for (int i = 0; i < n; ++i)
-                        {
-                          tfab.copy<RunOn::Device>(sfab, box, timestamp_indices[i], box, i, 1);
+                        int len = 1;
+                        while (i+len < n && timestamp_indices[i+len] == timestamp_indices[i]+len) {
+                            ++len;
                         }
-                      }
+                        AmrLevel::FillPatch(amr_level, tmf, ng, curr_time, State_Type,
+                                            timestamp_indices[i], len, i);
+                        i += len;
                     }
 
                     if (nextras > 0)
@@ -3947,7 +4498,11 @@ NavierStokesBase::post_timestep_particle (int crse_iteration)
                     }
                 }
 
-                NSPC->Timestamp(basename, tmf, lev, curr_time, tindices);
+                if (timestamp_binary) {
+                    write_binary_timestamp(basename, tmf, lev, curr_time);
+                } else {
+                    NSPC->Timestamp(basename, tmf, lev, curr_time, tindices);
+                }
             }
         }
     }
@@ -11,6 +11,7 @@
 
 #include <hydro_NodalProjector.H>
 
+#include <algorithm>
 
 using namespace amrex;
 
@@ -35,9 +36,105 @@ namespace
     bool use_harmonic_average = false;
     int max_fmg_iter = 0;
     int max_coarsening_level(-1);
+    int reuse_projector = 0;
+    int warm_start = 0;
 
     constexpr Real BogusValue = 1.e200;
     constexpr Real SmallValue = 1.e-200;
+
+#ifdef AMREX_USE_EB
+    //
+    // True if a and b, with the same layout, hold the same values in all their
+    // cells, ghost cells included.
+    //
+    bool same_values (const MultiFab& a, const MultiFab& b)
+    {
+        ReduceOps<ReduceOpMax> reduce_op;
+        ReduceData<int> reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+
+        for (MFIter mfi(a); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.fabbox();
+            auto const& fa = a.const_array(mfi);
+            auto const& fb = b.const_array(mfi);
+            const int ncomp = a.nComp();
+            reduce_op.eval(bx, reduce_data,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+            {
+                int diff = 0;
+                for (int n = 0; n < ncomp; n++) {
+                    diff = amrex::max(diff, int(fa(i,j,k,n) != fb(i,j,k,n)));
+                }
+                return {diff};
+            });
+        }
+
+        int diff = amrex::get<0>(reduce_data.value(reduce_op));
+        ParallelDescriptor::ReduceIntMax(diff);
+        return diff == 0;
+    }
+#endif
+}
+
+namespace
+{
+    //
+    // Contribution gravity*rho*dh of cell k to node column j of an outflow
+    // face, with rho extrapolated to the face from the cells i1 (next to the
+    // face) and i2 (next one in), and averaged to the tangential node j
+    // following the tangential density BCs at the edges of the face.
+    //
+    struct HydrostaticColumn
+    {
+        static constexpr int vdir = AMREX_SPACEDIM-1;
+
+        int  odir, tdir, i1, i2, tdomlo, tdomhi, bc_lo, bc_hi;
+        Real gravity, dh;
+
+        AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+        Real rho_at (Array4<Real const> const& r, int i, int j, int k) const noexcept
+        {
+            IntVect iv(AMREX_D_DECL(0,0,0));
+            iv[odir] = i;
+            iv[vdir] = k;
+#if (AMREX_SPACEDIM == 3)
+            iv[tdir] = j;
+#else
+            amrex::ignore_unused(j);
+#endif
+            return r(iv);
+        }
+
+        AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+        Real rho_face (Array4<Real const> const& r, int i, int j, int k) const noexcept
+        {
+#if (AMREX_SPACEDIM == 3)
+            auto rr = [&] (int jj) { return rho_at(r,i,jj,k); };
+            if (j == tdomlo) {
+                if (bc_lo == BCType::ext_dir)  return rr(j-1);
+                if (bc_lo == BCType::hoextrap) return 0.5*(3.*rr(j) - rr(j+1));
+                if (bc_lo == BCType::foextrap) return rr(j);
+            } else if (j == tdomhi+1) {
+                if (bc_hi == BCType::ext_dir)  return rr(j);
+                if (bc_hi == BCType::hoextrap) return 0.5*(3.*rr(j-1) - rr(j-2));
+                if (bc_hi == BCType::foextrap) return rr(j-1);
+            }
+            return 0.5*(rr(j) + rr(j-1));
+#else
+            return rho_at(r,i,j,k);
+#endif
+        }
+
+        AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+        Real operator() (Array4<Real const> const& r, int j, int k) const noexcept
+        {
+            const Real rho_i  = rho_face(r,i1,j,k);
+            const Real rho_ii = rho_face(r,i2,j,k);
+            const Real rhoExt = 0.5*(3.*rho_i-rho_ii);
+            return gravity*rhoExt*dh;
+        }
+    };
 }
 
 
@@ -63,6 +160,11 @@ Projection::Initialize ()
     pp.query("use_gauss_seidel",    use_gauss_seidel);
     pp.query("use_harmonic_average", use_harmonic_average);
     pp.query("mg_max_coarsening_level", max_coarsening_level);
+    pp.query("reuse_projector",     reuse_projector);
+    pp.query("warm_start",          warm_start);
+    if (warm_start < 0 || warm_start > 2) {
+        amrex::Abort("nodal_proj.warm_start must be 0, 1 or 2");
+    }
 
 
     // Abort if old verbose flag is found
@@ -117,6 +219,14 @@ Projection::Projection (Amr*   _parent,
 #endif
 }
 
+Projection::~Projection () = default;
+
+void
+Projection::invalidateNodalProjectorCache ()
+{
+    nodal_proj_cache.clear();
+}
+
 //
 // Install a level of the projection.
 //
@@ -139,6 +249,12 @@ Projection::install_level (int                     level,
     LevelData[level] = level_data;
     radius[level] = _radius;
 
+    // New level data means new grids (and factories)
+    invalidateNodalProjectorCache();
+    if (level < static_cast<int>(P_prev.size())) {
+        P_prev[level].reset();
+    }
+
 #ifdef AMREX_USE_EB
     const auto& _ebfactory =
       dynamic_cast<EBFArrayBoxFactory const&>(LevelData[level]->Factory());
@@ -240,6 +356,34 @@ Projection::level_project (int             level,
 
     const int nGrow = (level == 0  ?  0  :  -1);
     //
+    // Initial guess for the projection. By default it is zero. With
+    // nodal_proj.warm_start = 1 it is P_old, and with warm_start = 2 it is P_old
+    // linearly extrapolated in time using the previous step's P_old.
+    // Outflow (Dirichlet) boundary nodes stay zero. MLMG still measures
+    // convergence against the RHS norm, so the tolerance is unchanged.
+    //
+    if (static_cast<int>(P_prev.size()) <= level) {
+        P_prev.resize(level+1);
+        dt_prev.resize(level+1, 0.0);
+    }
+    const bool use_prev = warm_start == 2 && P_prev[level] != nullptr
+                          && P_prev[level]->boxArray() == P_grids
+                          && P_prev[level]->DistributionMap() == P_dmap
+                          && dt_prev[level] > 0.0;
+    const Real extrap = use_prev ? dt/dt_prev[level] : 0.0;
+    const int  wstart = warm_start;
+
+    // Nodes where the guess is used
+    Box guess_domain = amrex::surroundingNodes(geom.Domain());
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+    {
+        if (!geom.isPeriodic(idim))
+        {
+            if (phys_bc->lo(idim) == PhysBCType::outflow) guess_domain.growLo(idim,-1);
+            if (phys_bc->hi(idim) == PhysBCType::outflow) guess_domain.growHi(idim,-1);
+        }
+    }
+    //
     // MultiFab::setVal() won't work here bc nGrow could be <0
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
@@ -247,14 +391,37 @@ Projection::level_project (int             level,
     for (MFIter mfi(P_new,TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
        const Box& bx = mfi.growntilebox(nGrow);
-       auto const& pnew = P_new.array(mfi);
-       amrex::ParallelFor(bx, [pnew]
+       auto const& pnew  = P_new.array(mfi);
+       auto const& pold  = P_old.const_array(mfi);
+       auto const& pprev = use_prev ? P_prev[level]->const_array(mfi) : pold;
+       amrex::ParallelFor(bx, [pnew,pold,pprev,wstart,use_prev,extrap,guess_domain]
        AMREX_GPU_DEVICE (int i, int j, int k) noexcept
        {
-          pnew(i,j,k) = 0.0;
+          if (wstart > 0 && guess_domain.contains(IntVect(AMREX_D_DECL(i,j,k))))
+          {
+             Real p = pold(i,j,k);
+             if (use_prev) {
+                p += extrap*(p - pprev(i,j,k));
+             }
+             pnew(i,j,k) = p;
+          }
+          else
+          {
+             pnew(i,j,k) = 0.0;
+          }
        });
     }
 
+    if (warm_start == 2)
+    {
+        if (P_prev[level] == nullptr || !use_prev) {
+            P_prev[level] = std::make_unique<MultiFab>(P_grids, P_dmap, 1, 0, MFInfo(),
+                                                       LevelData[level]->Factory());
+        }
+        MultiFab::Copy(*P_prev[level], P_old, 0, 0, 1, 0);
+        dt_prev[level] = dt;
+    }
+
     //
     // Compute Ustar/dt + Gp                  for proj_2,
     //         (Ustar-Un)/dt for not proj_2 (ie the original).
@@ -1654,7 +1821,6 @@ Projection::initialVorticityProject (int c_lev)
 
 void
 Projection::putDown (const Vector<MultiFab*>& phi,
-                     FArrayBox*         phi_fine_strip,
                      int                c_lev,
                      int                f_lev,
                      const Orientation* outFaces,
@@ -1663,48 +1829,65 @@ Projection::putDown (const Vector<MultiFab*>& phi,
 {
     BL_PROFILE("Projection::putDown()");
     //
-    // Put down to coarser levels.
+    // Put down to coarser levels: inject the outflow nodes of each fine grid
+    // into a coarse strip piece on the rank owning that grid, and copy the
+    // pieces to the coarse level.
     //
-    const int nCompPhi = 1; // phi_fine_strip.nComp();
-    const int nGrow    = 0; // phi_fine_strip.nGrow();
+    const int nCompPhi = 1;
     IntVect ratio      = IntVect::TheUnitVector();
 
+    const MultiFab& phiF    = *phi[f_lev];
+    const Box&      domainF = parent->Geom(f_lev).Domain();
+
     for (int lev = f_lev-1; lev >= c_lev; lev--)
     {
         ratio *= parent->refRatio(lev);
         auto rr = ratio.dim3();
-        const Box& domainC = parent->Geom(lev).Domain();
 
         for (int iface = 0; iface < numOutFlowFaces; iface++)
         {
-            Box phiC_strip =
-                amrex::surroundingNodes(amrex::bdryNode(domainC, outFaces[iface], ncStripWidth));
-            phiC_strip.grow(nGrow);
-            BoxArray ba(phiC_strip);
+            const Box phiF_strip =
+                amrex::surroundingNodes(amrex::bdryNode(domainF, outFaces[iface], ncStripWidth));
 
-            // This is somewhat arbitrary but convenient
-            ba.maxSize(64);
+            BoxList     bl(IndexType::TheNodeType());
+            Vector<int> pmap;
+            Vector<int> gidx;
+            for (int g = 0; g < phiF.size(); ++g)
+            {
+                const Box b = phiF.boxArray()[g] & phiF_strip;
+                if (!b.ok()) continue;
+                //
+                // Coarse nodes whose fine counterpart lies in b.
+                //
+                IntVect clo, chi;
+                for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+                    clo[dir] = amrex::coarsen(b.smallEnd(dir)+ratio[dir]-1, ratio[dir]);
+                    chi[dir] = amrex::coarsen(b.bigEnd(dir), ratio[dir]);
+                }
+                const Box cb(clo, chi, IndexType::TheNodeType());
+                if (cb.ok()) {
+                    bl.push_back(cb);
+                    pmap.push_back(phiF.DistributionMap()[g]);
+                    gidx.push_back(g);
+                }
+            }
 
-            DistributionMapping dm{ba};
+            BoxArray ba(std::move(bl));
+            DistributionMapping dm(std::move(pmap));
             MultiFab phi_crse_strip(ba, dm, nCompPhi, 0);
-            phi_crse_strip.setVal(0);
-            const auto& phi_f_arr = phi_fine_strip[iface].array();
 
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
             for (MFIter mfi(phi_crse_strip); mfi.isValid(); ++mfi)
             {
-                Box ovlp = amrex::coarsen(phi_fine_strip[iface].box(),ratio) & mfi.validbox();
-                if (ovlp.ok())
+                const auto& phi_c_arr = phi_crse_strip.array(mfi);
+                const auto& phi_f_arr = phiF.const_array(gidx[mfi.index()]);
+                ParallelFor(mfi.validbox(), [phi_c_arr,phi_f_arr,rr]
+                AMREX_GPU_DEVICE (int i, int j, int k) noexcept
                 {
-                    const auto& phi_c_arr = phi_crse_strip.array(mfi);
-                    ParallelFor(ovlp, [phi_c_arr,phi_f_arr,rr]
-                    AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-                    {
-                       phi_c_arr(i,j,k) = phi_f_arr(i*rr.x,j*rr.y,k*rr.z);
-                    });
-                }
+                   phi_c_arr(i,j,k) = phi_f_arr(i*rr.x,j*rr.y,k*rr.z);
+                });
             }
             phi[lev]->ParallelCopy(phi_crse_strip);
         }
@@ -1856,7 +2039,7 @@ void
 Projection::set_outflow_bcs_at_level (int          /*which_call*/,
                                       int          lev,
                                       int          c_lev,
-                                      Box*         state_strip,
+                                      Box*         /*state_strip*/,
                                       Orientation* outFacesAtThisLevel,
                                       int          numOutFlowFaces,
                                       const Vector<MultiFab*>&  phi,
@@ -1868,514 +2051,287 @@ Projection::set_outflow_bcs_at_level (int          /*which_call*/,
 {
     AMREX_ASSERT(dynamic_cast<NavierStokesBase*>(LevelData[lev]) != nullptr);
 
-    Box domain = parent->Geom(lev).Domain();
+    const Box& domain = parent->Geom(lev).Domain();
 
     const int ncStripWidth = 1;
 
-    FArrayBox phi_fine_strip[2*AMREX_SPACEDIM];
-    FArrayBox            rho[2*AMREX_SPACEDIM];
-
-    const int ngrow = 1;
-
+    //
+    // Every rank only sets the outflow nodes of the grids it owns: phi = 0,
+    // or the hydrostatic pressure when there is gravity.
+    //
     for (int iface = 0; iface < numOutFlowFaces; iface++)
     {
-        Box phi_strip = amrex::surroundingNodes(amrex::bdryNode(domain,
-                                                outFacesAtThisLevel[iface],
-                                                ncStripWidth));
-        phi_fine_strip[iface].resize(phi_strip,1);
-        phi_fine_strip[iface].setVal<RunOn::Gpu>(0.);
-
-        rho[iface].resize(state_strip[iface],1);
-        (*Sig_in).copyTo(rho[iface],0,0,1,ngrow);
-        Gpu::streamSynchronize();
-    }
-
-    if (std::fabs(gravity) > 0.)
-      computeRhoG(rho,phi_fine_strip,
-                  parent->Geom(lev),
-                  outFacesAtThisLevel,numOutFlowFaces,gravity);
+        const Orientation& face = outFacesAtThisLevel[iface];
 
-    for ( int iface = 0; iface < numOutFlowFaces; iface++)
-    {
-        BoxArray phi_fine_strip_ba(phi_fine_strip[iface].box());
-
-        // This is somewhat arbitrary but convenient
-        phi_fine_strip_ba.maxSize(64);
-
-        DistributionMapping dm {phi_fine_strip_ba};
-        MultiFab phi_fine_strip_mf(phi_fine_strip_ba,dm,1,0);
+        if (std::fabs(gravity) > 0. && face.coordDir() != AMREX_SPACEDIM-1)
+        {
+            computeRhoG(*phi[lev], *Sig_in, parent->Geom(lev), face, gravity);
+        }
+        else
+        {
+            if (std::fabs(gravity) > 0. && face.faceDir() == Orientation::low) {
+                amrex::Abort("Projection::computeRhoG : Simulation box has outflow boundary condition on the bottom and gravity != 0. If this is really the desired configuration, just comment out this Abort");
+            }
+            //
+            // Hydrostatic pressure == 0 on the top, given IAMR definition
+            // of gravity.
+            //
+            const Box phi_strip = amrex::surroundingNodes(amrex::bdryNode(domain,face,ncStripWidth));
 
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-        for (MFIter mfi(phi_fine_strip_mf,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
-          const Box& bx = mfi.tilebox();
-          AMREX_ASSERT((phi_fine_strip[iface].box()).contains(bx));
-          const auto& phi_f_mf = phi_fine_strip_mf.array(mfi);
-          const auto& phi_f    = phi_fine_strip[iface].array();
-          amrex::ParallelFor(bx, [phi_f_mf,phi_f]
-          AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-          {
-             phi_f_mf(i,j,k) = phi_f(i,j,k);
-          });
+            for (MFIter mfi(*phi[lev]); mfi.isValid(); ++mfi)
+            {
+                const Box bx = mfi.validbox() & phi_strip;
+                if (bx.ok()) {
+                    auto const& phi_arr = phi[lev]->array(mfi);
+                    amrex::ParallelFor(bx, [phi_arr]
+                    AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                    {
+                        phi_arr(i,j,k) = 0.;
+                    });
+                }
+            }
         }
-
-        phi[lev]->ParallelCopy(phi_fine_strip_mf);
     }
 
     if (lev > c_lev)
     {
-      putDown(phi, phi_fine_strip, c_lev, lev, outFacesAtThisLevel,
+      putDown(phi, c_lev, lev, outFacesAtThisLevel,
                 numOutFlowFaces, ncStripWidth);
     }
 }
 
+//
+// Hydrostatic pressure phi = -int_z^top gravity*rho dz on the nodes of an
+// outflow face, integrated downwards from phi = 0 at the top of the domain.
+//
+// The face is split into the pieces of the grids that touch it, each held by
+// the rank owning the grid. The pieces are scanned from the top down one row
+// of pieces ("layer", a distinct piece bottom) at a time: a piece gets the
+// values at the bottom of the pieces above it with a ParallelCopy and then
+// integrates its own cells. Every node gets the same floating point sum as
+// integrating the whole column in one go, and the work and data scale with
+// the owned part of the face rather than the whole face.
+//
 void
-Projection::computeRhoG(FArrayBox*         rhoFab,
-                        FArrayBox*         phiFab,
-                        const Geometry&    geom,
-                        Orientation*       outFaces,
-                        int                numOutFlowFaces,
-                        Real               gravity)
+Projection::computeRhoG (MultiFab&          phi,
+                         const MultiFab&    Sig,
+                         const Geometry&    geom,
+                         const Orientation& face,
+                         Real               gravity)
 {
-    amrex::ignore_unused(this);
-    AMREX_ASSERT(std::fabs(gravity) > 0.);
+    BL_PROFILE("Projection::computeRhoG()");
 
-    for (int iface = 0; iface < numOutFlowFaces; iface++)
-    {
-      int outDir             = outFaces[iface].coordDir();
-      Orientation::Side side = outFaces[iface].faceDir();
-
-      if (outDir == (AMREX_SPACEDIM-1))
-      {
-          if (side == Orientation::high) {
-            //
-            // Hydrostatic pressure == 0 here, given IAMR definition of gravity.
-            // Do nothing, since phi already initialized to zero
-            //
-          } else {
-            amrex::Abort("Projection::computeRhoG : Simulation box has outflow boundary condition on the bottom and gravity != 0. If this is really the desired configuration, just comment out this Abort");
-          }
-      }
-      else // integrate rho * g* dh
-      {
-          const auto   lo = amrex::lbound(phiFab[iface].box());
-          const auto   hi = amrex::ubound(phiFab[iface].box());
-#ifdef AMREX_USE_GPU
-          FArrayBox h_phiFab(phiFab[iface].box(), phiFab[iface].nComp(),
-                             The_Pinned_Arena());
-          FArrayBox h_rhoFab(rhoFab[iface].box(), rhoFab[iface].nComp(),
-                             The_Pinned_Arena());
-          Gpu::dtoh_memcpy_async(h_phiFab.dataPtr(), phiFab[iface].dataPtr(),
-                                 h_phiFab.nBytes());
-          Gpu::dtoh_memcpy_async(h_rhoFab.dataPtr(), rhoFab[iface].dataPtr(),
-                                 h_rhoFab.nBytes());
-          Gpu::streamSynchronize();
-          const auto& phi = h_phiFab.array();
-          const auto& rho = h_rhoFab.array();
+    AMREX_ASSERT(std::fabs(gravity) > 0.);
+    AMREX_ASSERT(Sig.nGrow() >= 1);
+    AMREX_ASSERT(Sig.DistributionMap() == phi.DistributionMap());
+
+    constexpr int vdir = HydrostaticColumn::vdir;
+    const int     odir = face.coordDir();
+    const bool    high = (face.faceDir() == Orientation::high);
+#if (AMREX_SPACEDIM == 3)
+    const int     tdir = (odir == 0) ? 1 : 0;
 #else
-          const auto& phi = phiFab[iface].array();
-          const auto& rho = rhoFab[iface].array();
+    const int     tdir = odir;
 #endif
-          const Real dh = geom.CellSize(AMREX_SPACEDIM-1);
-
-          auto add_rhog = [gravity, dh] ( Real rho1, Real rho2,
-                                          Real& rhog_i, Real& phi_i )
-          {
-            Real rhoExt = 0.5*(3.*rho1-rho2);
-            rhog_i -= gravity * rhoExt * dh;
-            phi_i  += rhog_i;
-          };
+    AMREX_ASSERT(odir != vdir);
 
+    const Box&    domain = geom.Domain();
+    const Real    dh     = geom.CellSize(vdir);
 
-#if (AMREX_SPACEDIM == 2)
-          //
-          // Only possibilities are XLO face or XHI
-          //
-          // Ok to only use low index of phi because phi is only one
-          // node wide in i-direction.
-          //
-          AMREX_ASSERT( lo.x==hi.x );
-          int i = lo.x;
-
-          Real rhog = 0.;
-          //
-          // Note that the integral here prevents parallelization
-          //
-          if (side == Orientation::low)
-          {
-            for (int j = hi.y-1; j >= lo.y; j--) {
-              add_rhog(rho(i,j,0),rho(i+1,j,0),rhog,phi(i,j,0));
-            }
-          }
-          else
-          {
-            for (int j = hi.y-1; j >= lo.y; j--) {
-              add_rhog(rho(i-1,j,0),rho(i-2,j,0),rhog,phi(i,j,0));
-            }
-          }
-#else
-          const Box& domain = geom.Domain();
-          const auto domlo = amrex::lbound(domain);
-          const auto domhi = amrex::ubound(domain);
-
-          auto* ns = dynamic_cast<NavierStokesBase*>(LevelData[0]);
-          const auto* lo_bc = ns->m_bcrec_scalars[0].lo();
-          const auto* hi_bc = ns->m_bcrec_scalars[0].hi();
-
-          Real rho_i, rho_ii;
-
-          if ( outDir == int(Direction::x) )
-          {
-              //
-              // Ok to only use low index of phi because phi is only one
-              // node wide in i-direction.
-              //
-              AMREX_ASSERT( lo.x==hi.x );
-              int i = lo.x;
-
-              bool has_extdir_lo = (lo.y==domlo.y   && lo_bc[1]==BCType::ext_dir);
-              bool has_extdir_hi = (hi.y==domhi.y+1 && hi_bc[1]==BCType::ext_dir);
-              bool has_hoextrap_lo = (lo.y==domlo.y   && lo_bc[1]==BCType::hoextrap);
-              bool has_hoextrap_hi = (hi.y==domhi.y+1 && hi_bc[1]==BCType::hoextrap);
-              bool has_foextrap_lo = (lo.y==domlo.y   && lo_bc[1]==BCType::foextrap);
-              bool has_foextrap_hi = (hi.y==domhi.y+1 && hi_bc[1]==BCType::foextrap);
-
-              //
-              // If there are any of the above mentioned bcs, then we'll need to handle
-              // edges separately in accordance with those conditions, so set bounds for
-              // loop over j accordingly.
-              //
-              int jlo, jhi;
-              if ( has_extdir_lo || has_hoextrap_lo || has_foextrap_lo ) {
-                jlo = lo.y+1;
-              } else {
-                jlo = lo.y;
-              }
-              if ( has_extdir_hi || has_hoextrap_hi || has_foextrap_hi ) {
-                jhi = hi.y-1;
-              } else {
-                jhi = hi.y;
-              }
+    //
+    // Cells adjacent to the face (i1) and the next ones in (i2), and the nodes
+    // of the face.
+    //
+    const int i1    = high ? domain.bigEnd(odir)   : domain.smallEnd(odir);
+    const int i2    = high ? domain.bigEnd(odir)-1 : domain.smallEnd(odir)+1;
+    const int inode = high ? domain.bigEnd(odir)+1 : domain.smallEnd(odir);
 
-              //
-              // xlo face
-              //
-              if (side == Orientation::low)
-              {
-                for (int j = jlo; j <= jhi; j++)
-                {
-                  Real rhog = 0.;
+    Box face_row = domain;
+    face_row.setRange(odir, i1, 1);
 
-                  for (int k = hi.z-1; k >= lo.z; k--) {
-                    rho_i  = 0.5 * (rho(i  ,j,k) + rho(i  ,j-1,k));
-                    rho_ii = 0.5 * (rho(i+1,j,k) + rho(i+1,j-1,k));
-                    add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                  }
-                }
-                //
-                // Now compute y-edges if needed
-                //
-                if ( has_extdir_lo || has_hoextrap_lo || has_foextrap_lo )
-                {
-                  int j = lo.y;
-                  Real rhog = 0.;
-
-                  if ( has_extdir_lo ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i  = rho(i  ,j-1,k);
-                      rho_ii = rho(i+1,j-1,k);
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  } else if ( has_hoextrap_lo ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i  = 0.5*(3.*rho(i  ,j,k) - rho(i  ,j+1,k));
-                      rho_ii = 0.5*(3.*rho(i+1,j,k) - rho(i+1,j+1,k));
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  } else if ( has_foextrap_lo ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i  = rho(i  ,j,k);
-                      rho_ii = rho(i+1,j,k);
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  }
-                }
+    //
+    // The face pieces: the cells next to the face of each grid touching it,
+    // on the rank owning the grid. A grid may be a single cell wide normal to
+    // the face, so the second row of cells is not taken from the same grid.
+    //
+    const BoxArray& grids = Sig.boxArray();
+    BoxList         bl, rho_bl;
+    Vector<int>     pmap;
+    Vector<int>     gidx;
+    for (int g = 0; g < grids.size(); ++g)
+    {
+        Box b = grids[g] & face_row;
+        if (b.ok()) {
+            bl.push_back(b);
+            b.setRange(odir, std::min(i1,i2), 2);
+            rho_bl.push_back(b);
+            pmap.push_back(Sig.DistributionMap()[g]);
+            gidx.push_back(g);
+        }
+    }
+    const BoxArray            strip_ba(std::move(bl));
+    const DistributionMapping strip_dm(std::move(pmap));
 
-                if ( has_extdir_hi || has_hoextrap_hi || has_foextrap_hi )
-                {
-                  int j = hi.y;
-                  Real rhog = 0;
-
-                  if ( has_extdir_hi ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i  = rho(i  ,j,k);
-                      rho_ii = rho(i+1,j,k);
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  } else if ( has_hoextrap_hi ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i  = 0.5*(3.*rho(i  ,j-1,k) - rho(i  ,j-2,k));
-                      rho_ii = 0.5*(3.*rho(i+1,j-1,k) - rho(i+1,j-2,k));
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  } else if ( has_foextrap_hi ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i  = rho(i  ,j-1,k);
-                      rho_ii = rho(i+1,j-1,k);
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  }
-                }
-              }
-              else // xhi face
-              {
-                for (int j = jlo; j <= jhi; j++)
-                {
-                  Real rhog = 0.;
+    //
+    // Density on both rows of cells of the pieces, with one ghost cell, from
+    // the valid and ghost cells of Sig.
+    //
+    MultiFab rho(BoxArray(std::move(rho_bl)), strip_dm, 1, 1);
+    rho.ParallelCopy(Sig, 0, 0, 1, 1, 1, geom.periodicity());
 
-                  for (int k = hi.z-1; k >= lo.z; k--) {
-                    rho_i   = 0.5 * (rho(i-1,j,k) + rho(i-1,j-1,k));
-                    rho_ii = 0.5 * (rho(i-2,j,k) + rho(i-2,j-1,k));
-                    add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                  }
-                }
-                //
-                // Now compute y-edges if needed
-                //
-                if ( has_extdir_lo || has_hoextrap_lo || has_foextrap_lo )
-                {
-                  int j = lo.y;
-                  Real rhog = 0.;
-
-                  if ( has_extdir_lo ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i   = rho(i-1,j-1,k);
-                      rho_ii = rho(i-2,j-1,k);
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  } else if ( has_hoextrap_lo ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i   = 0.5*(3.*rho(i-1,j,k) - rho(i-1,j+1,k));
-                      rho_ii = 0.5*(3.*rho(i-2,j,k) - rho(i-2,j+1,k));
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  } else if ( has_foextrap_lo ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i   = rho(i-1,j,k);
-                      rho_ii = rho(i-2,j,k);
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  }
-                }
+    //
+    // Layers: the distinct bottoms of the pieces, from the bottom up.
+    //
+    Vector<int> klos;
+    for (int n = 0; n < strip_ba.size(); ++n) {
+        klos.push_back(strip_ba[n].smallEnd(vdir));
+    }
+    std::sort(klos.begin(), klos.end());
+    klos.erase(std::unique(klos.begin(), klos.end()), klos.end());
+    const int nlayers = klos.size();
+    auto layer_of = [&klos] (const Box& b)
+    {
+        return static_cast<int>(std::lower_bound(klos.begin(), klos.end(), b.smallEnd(vdir)) - klos.begin());
+    };
+
+    //
+    // Node columns of a piece: tangential nodes jlo..jhi+1. A piece owns the
+    // columns of its cells, plus the last one at the high side of the domain,
+    // and the nodes of those columns from its bottom up to its top cell, plus
+    // the top node at the top of the domain. Every node of the face then has
+    // exactly one owner.
+    //
+    // The boxes below live in the (column, node height) index space:
+    //   full: all the nodes of a piece,
+    //   own:  the nodes it owns,
+    //   top:  the node row above its top cell,
+    //   bot:  the bottom node row of its own columns.
+    //
+    const int tdomlo = domain.smallEnd(tdir);
+    const int tdomhi = domain.bigEnd(tdir);
+    const int vdomhi = domain.bigEnd(vdir);
+    auto col_lo = [&] (const Box& b) { return (AMREX_SPACEDIM == 3) ? b.smallEnd(tdir)   : 0; };
+    auto col_hi = [&] (const Box& b) { return (AMREX_SPACEDIM == 3) ? b.bigEnd(tdir)+1   : 0; };
+    auto own_hi = [&] (const Box& b)
+    {
+        if (AMREX_SPACEDIM != 3) return 0;
+        return (b.bigEnd(tdir) == tdomhi) ? b.bigEnd(tdir)+1 : b.bigEnd(tdir);
+    };
 
-                if ( has_extdir_hi || has_hoextrap_hi || has_foextrap_hi )
-                {
-                  int j = hi.y;
-                  Real rhog = 0;
-
-                  if ( has_extdir_hi ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i   = rho(i-1,j,k);
-                      rho_ii = rho(i-2,j,k);
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  } else if ( has_hoextrap_hi ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i   = 0.5*(3.*rho(i-1,j-1,k) - rho(i-1,j-2,k));
-                      rho_ii = 0.5*(3.*rho(i-2,j-1,k) - rho(i-2,j-2,k));
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  } else if ( has_foextrap_hi ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i   = rho(i-1,j-1,k);
-                      rho_ii = rho(i-2,j-1,k);
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  }
-                }
-              }
-          }
-          else // ( outDir == Direction::y )
-          {
-              //
-              // Ok to only use low index of phi because phi is only one
-              // node wide in i-direction.
-              //
-              AMREX_ASSERT( lo.y==hi.y );
-              int j = lo.y;
-
-              bool has_extdir_lo = (lo.x==domlo.x   && lo_bc[0]==BCType::ext_dir);
-              bool has_extdir_hi = (hi.x==domhi.x+1 && hi_bc[0]==BCType::ext_dir);
-              bool has_hoextrap_lo = (lo.x==domlo.x   && lo_bc[0]==BCType::hoextrap);
-              bool has_hoextrap_hi = (hi.x==domhi.x+1 && hi_bc[0]==BCType::hoextrap);
-              bool has_foextrap_lo = (lo.x==domlo.x   && lo_bc[0]==BCType::foextrap);
-              bool has_foextrap_hi = (hi.x==domhi.x+1 && hi_bc[0]==BCType::foextrap);
-              //
-              // If there are any of the above mentioned bcs, then we'll need to handle
-              // edges separately in accordance with those conditions, so set bounds for
-              // loop over i accordingly.
-              //
-              int ilo, ihi;
-              if ( has_extdir_lo || has_hoextrap_lo || has_foextrap_lo ) {
-                ilo = lo.x+1;
-              } else {
-                ilo = lo.x;
-              }
-              if ( has_extdir_hi || has_hoextrap_hi || has_foextrap_hi ) {
-                ihi = hi.x-1;
-              } else {
-                ihi = hi.x;
-              }
-              //
-              // ylo face
-              //
-              if (side == Orientation::low)
-              {
-                for (int i = ilo; i <= ihi; i++)
-                {
-                  Real rhog = 0.;
+    BoxList full_bl, own_bl, top_bl, bot_bl;
+    for (int n = 0; n < strip_ba.size(); ++n)
+    {
+        const Box& b   = strip_ba[n];
+        const int  klo = b.smallEnd(vdir);
+        const int  khi = b.bigEnd(vdir);
+        full_bl.push_back(Box(IntVect(AMREX_D_DECL(col_lo(b), klo  , 0)),
+                              IntVect(AMREX_D_DECL(col_hi(b), khi+1, 0))));
+        own_bl.push_back (Box(IntVect(AMREX_D_DECL(col_lo(b), klo  , 0)),
+                              IntVect(AMREX_D_DECL(own_hi(b), (khi == vdomhi) ? khi+1 : khi, 0))));
+        top_bl.push_back (Box(IntVect(AMREX_D_DECL(col_lo(b), khi+1, 0)),
+                              IntVect(AMREX_D_DECL(col_hi(b), khi+1, 0))));
+        bot_bl.push_back (Box(IntVect(AMREX_D_DECL(col_lo(b), klo  , 0)),
+                              IntVect(AMREX_D_DECL(own_hi(b), klo  , 0))));
+    }
+    MultiFab full(BoxArray(std::move(full_bl)), strip_dm, 1, 0);
+    MultiFab own (BoxArray(std::move(own_bl)),  strip_dm, 1, 0);
+    MultiFab top (BoxArray(std::move(top_bl)),  strip_dm, 1, 0);
+    MultiFab bot (BoxArray(std::move(bot_bl)),  strip_dm, 1, 0);
+
+    //
+    // Density BCs of the tangential direction, for the edges of the face.
+    //
+    auto* ns = dynamic_cast<NavierStokesBase*>(LevelData[0]);
+    const HydrostaticColumn rhog_k{odir, tdir, i1, i2, tdomlo, tdomhi,
+                                   ns->get_bcrec_scalars()[0].lo(tdir),
+                                   ns->get_bcrec_scalars()[0].hi(tdir),
+                                   gravity, dh};
+
+    //
+    // Scan the layers from the top down. Each piece picks up the values at
+    // the bottom of the pieces right above it and integrates its columns
+    // from there, cell by cell, so every node gets the same sum, in the same
+    // order, as integrating the whole column from the top of the domain.
+    //
+    top.setVal(0.);
+    bot.setVal(0.);
+    for (int l = nlayers-1; l >= 0; l--)
+    {
+        if (l < nlayers-1) {
+            top.ParallelCopy(bot);
+        }
 
-                  for (int k = hi.z-1; k >= lo.z; k--) {
-                    rho_i   = 0.5 * (rho(i,j  ,k) + rho(i-1,j ,k));
-                    rho_ii = 0.5 * (rho(i,j+1,k) + rho(i-1,j+1,k));
-                    add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                  }
-                }
-                //
-                // Now compute x-edges if needed
-                //
-                if ( has_extdir_lo || has_hoextrap_lo || has_foextrap_lo )
-                {
-                  int i = lo.x;
-                  Real rhog = 0.;
-
-                  if ( has_extdir_lo ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i   = rho(i-1,j  ,k);
-                      rho_ii = rho(i-1,j+1,k);
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  } else if ( has_hoextrap_lo ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i   = 0.5*(3.*rho(i,j  ,k) - rho(i+1,j  ,k));
-                      rho_ii = 0.5*(3.*rho(i,j+1,k) - rho(i+1,j+1,k));
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  } else if ( has_foextrap_lo ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i   = rho(i,j  ,k);
-                      rho_ii = rho(i,j+1,k);
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  }
+        for (MFIter mfi(full); mfi.isValid(); ++mfi)
+        {
+            const Box&  b   = strip_ba[mfi.index()];
+            if (layer_of(b) != l) continue;
+
+            const int   klo = b.smallEnd(vdir);
+            const int   khi = b.bigEnd(vdir);
+            const int   ohi = own_hi(b);
+            auto const& r   = rho.const_array(mfi);
+            auto const& t   = top.const_array(mfi);
+            auto const& f   = full.array(mfi);
+            auto const& bo  = bot.array(mfi);
+            const Box   cols(IntVect(AMREX_D_DECL(col_lo(b),0,0)), IntVect(AMREX_D_DECL(col_hi(b),0,0)));
+            amrex::ParallelFor(cols, [=]
+            AMREX_GPU_DEVICE (int j, int, int) noexcept
+            {
+                Real rhog = t(IntVect(AMREX_D_DECL(j,khi+1,0)));
+                f(IntVect(AMREX_D_DECL(j,khi+1,0))) = rhog;
+                for (int k = khi; k >= klo; k--) {
+                    rhog -= rhog_k(r, j, k);
+                    f(IntVect(AMREX_D_DECL(j,k,0))) = rhog;
                 }
-
-                if ( has_extdir_hi || has_hoextrap_hi || has_foextrap_hi )
-                {
-                  int i = hi.x;
-                  Real rhog = 0;
-
-                  if ( has_extdir_hi ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i   = rho(i,j  ,k);
-                      rho_ii = rho(i,j+1,k);
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  } else if ( has_hoextrap_hi ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i   = 0.5*(3.*rho(i-1,j  ,k) - rho(i-2,j  ,k));
-                      rho_ii = 0.5*(3.*rho(i-1,j+1,k) - rho(i-2,j+1,k));
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  } else if ( has_foextrap_hi ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i   = rho(i-1,j  ,k);
-                      rho_ii = rho(i-1,j+1,k);
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  }
+                if (j <= ohi) {
+                    bo(IntVect(AMREX_D_DECL(j,klo,0))) = rhog;
                 }
-              }
-              else // yhi face
-              {
-                for (int i = ilo; i <= ihi; i++)
-                {
-                  Real rhog = 0.;
+            });
+        }
+    }
 
-                  for (int k = hi.z-1; k >= lo.z; k--) {
-                    rho_i   = 0.5 * (rho(i,j-1,k) + rho(i-1,j-1,k));
-                    rho_ii = 0.5 * (rho(i,j-1,k) + rho(i-1,j-2,k));
-                    add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                  }
-                }
-                //
-                // Now compute y-edges if needed
-                //
-                if ( has_extdir_lo || has_hoextrap_lo || has_foextrap_lo )
-                {
-                  int i = lo.x;
-                  Real rhog = 0.;
-
-                  if ( has_extdir_lo ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i   = rho(i-1,j-1,k);
-                      rho_ii = rho(i-2,j-1,k);
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  } else if ( has_hoextrap_lo ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i   = 0.5*(3.*rho(i,j-1,k) - rho(i+1,j-1,k));
-                      rho_ii = 0.5*(3.*rho(i,j-2,k) - rho(i+1,j-2,k));
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  } else if ( has_foextrap_lo ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i   = rho(i,j-1,k);
-                      rho_ii = rho(i,j-2,k);
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  }
-                }
+    //
+    // Neighbouring pieces share the nodes of their common edges. Copy the
+    // nodes each piece owns over all the pieces, so every shared node gets
+    // one value, then write phi.
+    //
+    for (MFIter mfi(own); mfi.isValid(); ++mfi)
+    {
+        auto const& f = full.const_array(mfi);
+        auto const& o = own.array(mfi);
+        amrex::ParallelFor(mfi.validbox(), [=]
+        AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            o(i,j,k) = f(i,j,k);
+        });
+    }
 
-                if ( has_extdir_hi || has_hoextrap_hi || has_foextrap_hi )
-                {
-                  int i = hi.x;
-                  Real rhog = 0;
-
-                  if ( has_extdir_hi ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i   = rho(i,j-1,k);
-                      rho_ii = rho(i,j-2,k);
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  } else if ( has_hoextrap_hi ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i   = 0.5*(3.*rho(i-1,j-1,k) - rho(i-2,j-1,k));
-                      rho_ii = 0.5*(3.*rho(i-1,j-2,k) - rho(i-2,j-2,k));
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  } else if ( has_foextrap_hi ) {
-                    for (int k = hi.z-1; k >= lo.z; k--) {
-                      rho_i   = rho(i-1,j-1,k);
-                      rho_ii = rho(i-1,j-2,k);
-                      add_rhog(rho_i, rho_ii, rhog, phi(i,j,k));
-                    }
-                  }
-                }
-              } // endif over hi/low sides
-          } // endif over directions
-#endif
+    full.ParallelCopy(own);
 
-#ifdef AMREX_USE_GPU
-          Gpu::htod_memcpy_async(phiFab[iface].dataPtr(), h_phiFab.dataPtr(),
-                                 phiFab[iface].nBytes());
-          Gpu::htod_memcpy_async(rhoFab[iface].dataPtr(), h_rhoFab.dataPtr(),
-                                 rhoFab[iface].nBytes());
-          Gpu::streamSynchronize();
+    for (MFIter mfi(full); mfi.isValid(); ++mfi)
+    {
+        auto const& f = full.const_array(mfi);
+        auto const& p = phi.array(gidx[mfi.index()]);
+        amrex::ParallelFor(mfi.validbox(), [=]
+        AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            IntVect iv(AMREX_D_DECL(0,0,0));
+            iv[odir] = inode;
+#if (AMREX_SPACEDIM == 3)
+            iv[tdir] = i;
+            iv[vdir] = j;
+            amrex::ignore_unused(k);
+#else
+            iv[vdir] = j;
+            amrex::ignore_unused(i,k);
 #endif
-      } // endif integrate rho*g*dh
-    } // end loop over outflow faces
+            p(iv) = f(i,j,k);
+        });
+    }
+    Gpu::streamSynchronize();
 }
 
 //
@@ -2509,8 +2465,139 @@ void Projection::doMLMGNodalProjection (int c_lev, int nlevel,
     }
 
     // Setup nodal projector object
-    Hydro::NodalProjector nodal_projector(vel_rebase, GetVecOfConstPtrs(sigma_rebase), mg_geom, info, rhcc_rebase, rhnd_rebase);
-    nodal_projector.setDomainBC(mlmg_lobc, mlmg_hibc);
+    std::unique_ptr<Hydro::NodalProjector> local_projector;
+    NodalProjCache* cache = nullptr;
+
+    if (reuse_projector)
+    {
+        //
+        // Reuse the projector (and its MLNodeLaplacian hierarchy) built for the same
+        // levels, grids and boundary conditions; vel, sigma and the RHS are updated
+        // in place.
+        //
+        std::vector<int> key = {c_lev, nlevel, int(doing_initial_vortproj),
+                                int(sync_resid_crse != nullptr), int(sync_resid_fine != nullptr)};
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            key.push_back(static_cast<int>(mlmg_lobc[idim]));
+            key.push_back(static_cast<int>(mlmg_hibc[idim]));
+        }
+        for (int lev = 0; lev < nlevel; lev++)
+        {
+            key.push_back(vel_rebase[lev]->nGrow());
+            key.push_back(sigma_rebase[lev]->nGrow());
+            key.push_back((!rhcc_rebase.empty() && rhcc_rebase[lev]) ? rhcc_rebase[lev]->nGrow() : -1);
+            key.push_back((!rhnd_rebase.empty() && rhnd_rebase[lev]) ? rhnd_rebase[lev]->nGrow() : -1);
+        }
+
+        cache = &nodal_proj_cache[key];
+        if (cache->projector)
+        {
+            for (int lev = 0; lev < nlevel; lev++)
+            {
+                if (cache->grids[lev] != mg_grids[lev] || cache->dmap[lev] != mg_dmap[lev]) {
+                    cache->projector.reset();
+                    break;
+                }
+            }
+        }
+#ifdef AMREX_USE_EB
+        //
+        // With EB the stencil is built from the sigma the projector was made
+        // with, so here it is only kept while sigma is unchanged (e.g. constant
+        // density). Any change in sigma, ghost cells included, rebuilds it.
+        //
+        if (cache->projector)
+        {
+            for (int lev = 0; lev < nlevel; lev++)
+            {
+                if (!same_values(*cache->sigma[lev], *sigma_rebase[lev])) {
+                    if (verbose) {
+                        amrex::Print() << "Projection: sigma changed, rebuilding nodal projector\n";
+                    }
+                    cache->projector.reset();
+                    break;
+                }
+            }
+        }
+#endif
+
+        // Copy of src with the same layout, or nullptr
+        auto make_copy = [&] (const MultiFab* src, int lev) -> std::unique_ptr<MultiFab>
+        {
+            if (src == nullptr) return nullptr;
+            return std::make_unique<MultiFab>(src->boxArray(), src->DistributionMap(),
+                                              src->nComp(), src->nGrow(), MFInfo(),
+                                              LevelData[lev+c_lev]->Factory());
+        };
+
+        if (!cache->projector)
+        {
+            if (verbose) {
+                amrex::Print() << "Projection: building nodal projector for levels "
+                               << c_lev << " to " << f_lev << '\n';
+            }
+            cache->grids = mg_grids;
+            cache->dmap  = mg_dmap;
+            cache->vel.clear();
+            cache->sigma.clear();
+            cache->rhcc.clear();
+            cache->rhnd.clear();
+            for (int lev = 0; lev < nlevel; lev++)
+            {
+                cache->vel.push_back(make_copy(vel_rebase[lev], lev));
+                cache->sigma.push_back(make_copy(sigma_rebase[lev], lev));
+                MultiFab::Copy(*cache->sigma[lev], *sigma_rebase[lev], 0, 0,
+                               sigma_rebase[lev]->nComp(), sigma_rebase[lev]->nGrow());
+                if (!rhcc_rebase.empty()) {
+                    cache->rhcc.push_back(make_copy(rhcc_rebase[lev], lev));
+                }
+                if (!rhnd_rebase.empty()) {
+                    cache->rhnd.push_back(make_copy(rhnd_rebase[lev], lev));
+                }
+            }
+
+            cache->projector = std::make_unique<Hydro::NodalProjector>(
+                GetVecOfPtrs(cache->vel), GetVecOfConstPtrs(cache->sigma), mg_geom, info,
+                GetVecOfPtrs(cache->rhcc), GetVecOfConstPtrs(cache->rhnd));
+            cache->projector->setDomainBC(mlmg_lobc, mlmg_hibc);
+        }
+        else
+        {
+            //
+            // The coarse level coefficients are averaged down from these when
+            // MLMG prepares the solve.
+            //
+            for (int lev = 0; lev < nlevel; lev++)
+            {
+                MultiFab::Copy(*cache->sigma[lev], *sigma_rebase[lev], 0, 0,
+                               sigma_rebase[lev]->nComp(), sigma_rebase[lev]->nGrow());
+                cache->projector->getLinOp().setSigma(lev, *cache->sigma[lev]);
+            }
+        }
+
+        for (int lev = 0; lev < nlevel; lev++)
+        {
+            MultiFab::Copy(*cache->vel[lev], *vel_rebase[lev], 0, 0,
+                           vel_rebase[lev]->nComp(), vel_rebase[lev]->nGrow());
+            if (!cache->rhcc.empty() && cache->rhcc[lev]) {
+                MultiFab::Copy(*cache->rhcc[lev], *rhcc_rebase[lev], 0, 0,
+                               rhcc_rebase[lev]->nComp(), rhcc_rebase[lev]->nGrow());
+            }
+            if (!cache->rhnd.empty() && cache->rhnd[lev]) {
+                MultiFab::Copy(*cache->rhnd[lev], *rhnd_rebase[lev], 0, 0,
+                               rhnd_rebase[lev]->nComp(), rhnd_rebase[lev]->nGrow());
+            }
+        }
+    }
+    else
+    {
+        local_projector = std::make_unique<Hydro::NodalProjector>(
+            vel_rebase, GetVecOfConstPtrs(sigma_rebase), mg_geom, info, rhcc_rebase, rhnd_rebase);
+        local_projector->setDomainBC(mlmg_lobc, mlmg_hibc);
+    }
+
+    Hydro::NodalProjector& nodal_projector = (cache != nullptr) ? *cache->projector
+                                                                : *local_projector;
 
 // WARNING: we set the strategy to Sigma to get exactly the same results as the no EB code
 // when we don't have interior geometry
@@ -2536,6 +2623,14 @@ void Projection::doMLMGNodalProjection (int c_lev, int nlevel,
     //
     nodal_projector.project(phi_rebase,rel_tol,abs_tol);
 
+    if (cache != nullptr)
+    {
+        for (int lev = 0; lev < nlevel; lev++) {
+            MultiFab::Copy(*vel_rebase[lev], *cache->vel[lev], 0, 0,
+                           vel_rebase[lev]->nComp(), vel_rebase[lev]->nGrow());
+        }
+    }
+
     //
     // Update gradP
     //
@@ -1,5 +1,14 @@
 #include "Utilities.H"
 
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#include <AMReX_ParallelDescriptor.H>
+
 // -----------------------------------------------------------
 // Read a binary file
 // INPUTS/OUTPUTS:
@@ -18,17 +27,124 @@ read_binary(
   const size_t ncol,
   amrex::Vector<double>& data /*needs to be double*/)
 {
+  read_binary_planes(iname, nx, ny, nz, ncol, 0, static_cast<int>(nz) - 1, data);
+}
+
+// -----------------------------------------------------------
+// Read the z planes klo..khi of a binary file holding ncol doubles
+// per point, points in Fortran order (x fastest). Each rank can
+// call this for only the planes it needs.
+// INPUTS/OUTPUTS:
+// iname => filename
+// nx    => input resolution
+// ny    => input resolution
+// nz    => input resolution
+// ncol  => number of values per point
+// klo   => first plane to read
+// khi   => last plane to read
+// data  <= output data, planes klo..khi (empty if khi < klo)
+// -----------------------------------------------------------
+void
+read_binary_planes(
+  const std::string& iname,
+  const size_t nx,
+  const size_t ny,
+  const size_t nz,
+  const size_t ncol,
+  const int klo,
+  const int khi,
+  amrex::Vector<double>& data)
+{
+  // Empty range, e.g. from local_plane_range on a rank with no boxes
+  if (khi < klo) {
+    data.clear();
+    return;
+  }
+  AMREX_ALWAYS_ASSERT(0 <= klo && khi < static_cast<int>(nz));
+
   std::ifstream infile(iname, std::ios::in | std::ios::binary);
   if (not infile.is_open()) {
     amrex::Abort("Unable to open input file " + iname);
   }
 
-  for (size_t i = 0; i < nx * ny * nz * ncol; i++) {
-    infile.read(reinterpret_cast<char*>(&data[i]), sizeof(data[i]));
+  const size_t plane = nx * ny * ncol;
+  const size_t count = (khi - klo + 1) * plane;
+  data.resize(count);
+
+  // Quick sanity check
+  infile.seekg(0, std::ios::end);
+  const auto fsize = static_cast<size_t>(infile.tellg());
+  if (fsize != nx * ny * nz * ncol * sizeof(double)) {
+    amrex::Abort(
+      "Size of the input file " + iname + " (= " + std::to_string(fsize) +
+      " bytes) does not match the input resolution");
+  }
+
+  // Read in large blocks rather than one value at a time
+  infile.seekg(klo * plane * sizeof(double), std::ios::beg);
+  constexpr size_t block = size_t(1) << 23; // values per read (64 MiB)
+  for (size_t start = 0; start < count; start += block) {
+    const size_t n = std::min(block, count - start);
+    infile.read(reinterpret_cast<char*>(data.data() + start), n * sizeof(double));
+    if (not infile) {
+      amrex::Abort("Failed reading input file " + iname);
+    }
   }
   infile.close();
 }
 
+// -----------------------------------------------------------
+// Range of z planes of a uniform nz-point table, with points from
+// zlo to zhi, needed to interpolate onto the (grown) boxes of ba
+// owned by this rank. Pass it to read_binary_planes so each rank
+// only reads the slab covering its own boxes.
+// INPUTS/OUTPUTS:
+// ba, dm => boxes and their owners
+// geom   => geometry of the level
+// ngrow  => ghost cells to cover
+// nz     => table resolution in z
+// zlo    => z of the first table plane
+// zhi    => z of the last table plane
+// klo    <= first plane needed
+// khi    <= last plane needed (klo = 0, khi = -1 if this rank owns
+//           no boxes: skip the read or pass the empty range on)
+// -----------------------------------------------------------
+void
+local_plane_range(
+  const amrex::BoxArray& ba,
+  const amrex::DistributionMapping& dm,
+  const amrex::Geometry& geom,
+  const int ngrow,
+  const size_t nz,
+  const amrex::Real zlo,
+  const amrex::Real zhi,
+  int& klo,
+  int& khi)
+{
+  const int dir = AMREX_SPACEDIM - 1;
+  const int myproc = amrex::ParallelDescriptor::MyProc();
+  const amrex::Real dz = (nz > 1) ? (zhi - zlo) / (nz - 1) : 1.0;
+  const int kmax = static_cast<int>(nz) - 1;
+
+  klo = static_cast<int>(nz);
+  khi = -1;
+  for (int i = 0; i < ba.size(); i++) {
+    if (dm[i] != myproc) {
+      continue;
+    }
+    const amrex::Box bx = amrex::grow(ba[i], ngrow);
+    const amrex::Real blo = geom.ProbLo(dir) + bx.smallEnd(dir) * geom.CellSize(dir);
+    const amrex::Real bhi = geom.ProbLo(dir) + (bx.bigEnd(dir) + 1) * geom.CellSize(dir);
+    const int lo = static_cast<int>(std::floor((blo - zlo) / dz));
+    const int hi = static_cast<int>(std::floor((bhi - zlo) / dz)) + 1;
+    klo = std::min(klo, amrex::max(0, amrex::min(lo, kmax)));
+    khi = std::max(khi, amrex::max(0, amrex::min(hi, kmax)));
+  }
+  if (khi < 0) {
+    klo = 0;
+  }
+}
+
 // -----------------------------------------------------------
 // Read a csv file
 // INPUTS/OUTPUTS:
@@ -46,20 +162,29 @@ read_csv(
   const size_t nz,
   amrex::Vector<amrex::Real>& data)
 {
-  std::ifstream infile(iname, std::ios::in);
-  const std::string memfile = read_file(infile);
+  std::ifstream infile(iname, std::ios::in | std::ios::binary);
   if (not infile.is_open()) {
     amrex::Abort("Unable to open input file " + iname);
   }
+
+  // Slurp the file with a single read
+  infile.seekg(0, std::ios::end);
+  std::string memfile(static_cast<size_t>(infile.tellg()), '\0');
+  infile.seekg(0, std::ios::beg);
+  infile.read(&memfile[0], memfile.size());
   infile.close();
-  std::istringstream iss(memfile);
-
-  // Read the file
-  size_t nlines = 0;
-  std::string firstline;
-  std::string line;
-  std::getline(iss, firstline); // skip header
-  while (getline(iss, line)) {
+
+  const char* p = memfile.c_str();
+  const char* const end = p + memfile.size();
+
+  // Skip header
+  p = static_cast<const char*>(std::memchr(p, '\n', end - p));
+  p = (p == nullptr) ? end : p + 1;
+
+  // Count the lines after the header: one per newline, plus a last
+  // line without a trailing newline
+  size_t nlines = std::count(p, end, '\n');
+  if (end > p && end[-1] != '\n') {
     ++nlines;
   }
 
@@ -70,18 +195,22 @@ read_csv(
       ") does not match the input resolution (=" + std::to_string(nx) + ")");
   }
 
-  // Read the data from the file
-  iss.clear();
-  iss.seekg(0, std::ios::beg);
-  std::getline(iss, firstline); // skip header
-  int cnt = 0;
-  while (std::getline(iss, line)) {
-    std::istringstream linestream(line);
-    std::string value;
-    while (getline(linestream, value, ',')) {
-      std::istringstream sinput(value);
-      sinput >> data[cnt];
-      cnt++;
+  // Parse the values in place, skipping separators
+  size_t cnt = 0;
+  while (p < end) {
+    if (*p == ',' || std::isspace(static_cast<unsigned char>(*p))) {
+      ++p;
+      continue;
+    }
+    char* next = nullptr;
+    const double value = std::strtod(p, &next);
+    if (next == p) {
+      amrex::Abort("Unable to parse value in input file " + iname);
+    }
+    if (cnt >= data.size()) {
+      amrex::Abort("More values in the input file " + iname + " than expected");
     }
+    data[cnt++] = static_cast<amrex::Real>(value);
+    p = next;
   }
 }
@@ -1,13 +1,102 @@
 
 #include <NavierStokesBase.H>
 #ifdef AMREX_USE_TURBULENT_FORCING
+#include <NavierStokes.H>
 #include <iamr_constants.H>
 #include <TurbulentForcing_params.H>
+#include <TurbulentForcing_K.H>
 #endif
 
 
 using namespace amrex;
 
+#ifdef AMREX_USE_TURBULENT_FORCING
+#include <map>
+#include <memory>
+
+namespace {
+
+//
+// Fill tab(i,kk,0,{0,1}) = {cos,sin}(TwoPi*kk*x_i/L), with x_i = xlo + (i+offset)*h,
+// for i in [lo,hi] and wavenumbers kk in [0,kmax].
+//
+void
+fillTrigTable (FArrayBox& tab, int lo, int hi, int kmax,
+               Real xlo, Real h, Real offset, Real L)
+{
+    tab.resize(Box(IntVect(lo,0,0),IntVect(hi,kmax,0)),2);
+    auto const& t = tab.array();
+    amrex::ParallelFor(tab.box(), [=]
+    AMREX_GPU_DEVICE (int i, int kk, int) noexcept
+    {
+        Real arg = TwoPi*kk*(xlo + (i+offset)*h)/L;
+        t(i,kk,0,0) = std::cos(arg);
+        t(i,kk,0,1) = std::sin(arg);
+    });
+}
+
+//
+// The 1-D trig tables only depend on the level's geometry, so they are built once
+// per level over the domain (plus a few ghost cells), indexed by global cell index,
+// and reused by every later getForce call on that level.
+//
+struct TrigTables
+{
+    Box       covered;
+    FArrayBox tab[3];
+};
+
+std::map<int,std::unique_ptr<TrigTables>> trig_table_cache;
+
+const TrigTables&
+getTrigTables (const Geometry& geom, int lev, const int kmax[3])
+{
+    TrigTables* tt = nullptr;
+#ifdef _OPENMP
+#pragma omp critical (turb_trig_tables)
+#endif
+    {
+        if (trig_table_cache.empty()) {
+            // FArrayBox memory must go back to the arenas before they are finalized
+            amrex::ExecOnFinalize([] () { trig_table_cache.clear(); });
+        }
+        auto& p = trig_table_cache[lev];
+        if (!p)
+        {
+            p = std::make_unique<TrigTables>();
+            p->covered = amrex::grow(geom.Domain(),4);
+            for (int d = 0; d < 3; d++) {
+                fillTrigTable(p->tab[d], p->covered.smallEnd(d), p->covered.bigEnd(d), kmax[d],
+                              geom.ProbLo(d), geom.CellSize(d), 0.5, geom.ProbLength(d));
+            }
+            Gpu::streamSynchronize();
+        }
+        tt = p.get();
+    }
+    return *tt;
+}
+
+//
+// Fill xT(m) = cos(FTX*time+TAT) for the active forcing modes.
+//
+void
+fillTimeCoefficients (FArrayBox& xT, Real time)
+{
+    const int nm = TurbulentForcing::nmodes_active;
+    xT.resize(Box(IntVect(0,0,0),IntVect(std::max(nm,1)-1,0,0)),1);
+    Real* xTp = xT.dataPtr();
+    Real const* md = TurbulentForcing::modedata;
+    amrex::ParallelFor(nm, [=]
+    AMREX_GPU_DEVICE (int m) noexcept
+    {
+        using namespace TurbulentForcing;
+        xTp[m] = std::cos(md[m*mode_ncoef+md_ftx]*time + md[m*mode_ncoef+md_tat]);
+    });
+}
+
+}
+#endif
+
 //
 // Virtual access function for getting the forcing terms for the
 // velocities and scalars.  The base version computes a buoyancy.
@@ -218,8 +307,7 @@ NavierStokesBase::getForce (FArrayBox&       force,
      Real Lmin = min(Lx,Ly,Lz);
 
 
-     // For now, only works in 3D and without tiling
-     AMREX_ALWAYS_ASSERT(bx==force.box());
+     // Only works in 3D
      AMREX_ASSERT(AMREX_SPACEDIM==3);
 
      int xstep = static_cast<int>(Lx/Lmin+0.5);
@@ -228,12 +316,6 @@ NavierStokesBase::getForce (FArrayBox&       force,
 
      Real kappaMax = TurbulentForcing::nmodes/Lmin + 1.0e-8;
 
-     // force array bounds
-     // FIXME -- think about how bx (the box we want to fill) may not be the same as the force box!
-     int ilo = f_lo[0];
-     int jlo = f_lo[1];
-     int klo = f_lo[2];
-
      auto const&  dx = geom.CellSizeArray();
      Real hx = dx[0];
      Real hy = dx[1];
@@ -292,418 +374,315 @@ NavierStokesBase::getForce (FArrayBox&       force,
      //
      //amrex::Abort();
 
-     RealBox loc = RealBox(bx,geom.CellSize(),geom.ProbLo());
-     const auto& loc_lo = loc.lo();
-     amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> xlo = {AMREX_D_DECL(loc_lo[0],loc_lo[1],loc_lo[2])};
-
+     // Largest wavenumber index in each direction
+     const int kmax[3] = {TurbulentForcing::nmodes*xstep,
+                          TurbulentForcing::nmodes*ystep,
+                          TurbulentForcing::nmodes*zstep};
 
-#ifdef AMREX_USE_FAST_FORCE
-     //
-     // Construct force at fewer points and then interpolate.
-     // This is much faster on CPU.
-     //
-
-     int ihi = f_hi[0];
-     int jhi = f_hi[1];
-     int khi = f_hi[2];
-
-     // coarse cell size
-     Real ff_hx = hx*TurbulentForcing::ff_factor;
-     Real ff_hy = hy*TurbulentForcing::ff_factor;
-     Real ff_hz = hz*TurbulentForcing::ff_factor;
+     auto const& dens = Scal.array(scalScomp);
 
-     // coarse bounds (without accounting for ghost cells)
-     // FIXME -- think about how bx (the box we want to fill) may not be the same as the force box!
-     int ff_ilo = ilo/TurbulentForcing::ff_factor;
-     int ff_jlo = jlo/TurbulentForcing::ff_factor;
-     int ff_klo = klo/TurbulentForcing::ff_factor;
+     // All points are located from the global index, x_i = problo + (i+0.5)*dx,
+     // so bx may be any box: a tile, a grown box or just part of force.box().
 
-     int ff_ihi = (ihi+1)/TurbulentForcing::ff_factor;
-     int ff_jhi = (jhi+1)/TurbulentForcing::ff_factor;
-     int ff_khi = (khi+1)/TurbulentForcing::ff_factor;
+     const int ff = TurbulentForcing::ff_factor;
 
-     // adjust for ghost cells
-     if (ilo < (ff_ilo*TurbulentForcing::ff_factor)) {
-         ff_ilo=ff_ilo-1;
-     }
-     if (jlo < (ff_jlo*TurbulentForcing::ff_factor)) {
-         ff_jlo=ff_jlo-1;
-     }
-     if (klo < (ff_klo*TurbulentForcing::ff_factor)) {
-         ff_klo=ff_klo-1;
-     }
-     if (ihi == (ff_ihi*TurbulentForcing::ff_factor)) {
-         ff_ihi=ff_ihi+1;
-     }
-     if (jhi == (ff_jhi*TurbulentForcing::ff_factor)) {
-         ff_jhi=ff_jhi+1;
-     }
-     if (khi == (ff_khi*TurbulentForcing::ff_factor)) {
-         ff_khi=ff_khi+1;
+     if (ff > 1)
+     {
+         //
+         // Construct force at fewer points and then interpolate.
+         // This is much faster on CPU.
+         // The coarse points are the nodes of the domain coarsened by ff_factor,
+         // X_I = problo + I*ff*dx, so every box sees the same coarse field.
+         //
+         Box nbx = amrex::coarsen(bx,ff);
+         nbx.growHi(0,1).growHi(1,1).growHi(2,1);
+
+         FArrayBox tabx, taby, tabz, xTfab;
+         fillTrigTable(tabx, nbx.smallEnd(0), nbx.bigEnd(0), kmax[0], problo[0], ff*hx, 0.0, Lx);
+         fillTrigTable(taby, nbx.smallEnd(1), nbx.bigEnd(1), kmax[1], problo[1], ff*hy, 0.0, Ly);
+         fillTrigTable(tabz, nbx.smallEnd(2), nbx.bigEnd(2), kmax[2], problo[2], ff*hz, 0.0, Lz);
+         fillTimeCoefficients(xTfab, time);
+
+         FArrayBox ff_force(nbx,AMREX_SPACEDIM);
+         Elixir tabx_e = tabx.elixir();
+         Elixir taby_e = taby.elixir();
+         Elixir tabz_e = tabz.elixir();
+         Elixir xT_e   = xTfab.elixir();
+         Elixir ff_e   = ff_force.elixir();
+
+         auto const& tx    = tabx.const_array();
+         auto const& ty    = taby.const_array();
+         auto const& tz    = tabz.const_array();
+         auto const& ffarr = ff_force.array();
+         Real const* xT    = xTfab.dataPtr();
+         int  const* midx  = TurbulentForcing::modeidx;
+         Real const* mdata = TurbulentForcing::modedata;
+         const int   nm    = TurbulentForcing::nmodes_active;
+         const bool  div_free = TurbulentForcing::div_free_force;
+
+         // Construct node-based coarse forcing
+         amrex::ParallelFor(nbx, [=]
+         AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+         {
+             Real f[3];
+             TurbulentForcing::force_from_tables_k(i, j, k, f, tx, ty, tz,
+                                                   nm, midx, mdata, xT, div_free);
+             ffarr(i,j,k,0) = f[0];
+             ffarr(i,j,k,1) = f[1];
+             ffarr(i,j,k,2) = f[2];
+         });
+
+         // Now trilinearly interpolate onto the cell centers of bx
+         amrex::ParallelFor(bx, AMREX_SPACEDIM, [=]
+         AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+         {
+             const IntVect civ = amrex::coarsen(IntVect(i,j,k),ff);
+             const int ff_i = civ[0];
+             const int ff_j = civ[1];
+             const int ff_k = civ[2];
+
+             Real xd = (i + 0.5 - ff_i*ff)/ff;
+             Real yd = (j + 0.5 - ff_j*ff)/ff;
+             Real zd = (k + 0.5 - ff_k*ff)/ff;
+
+             Real ff00 =  ffarr(ff_i  ,ff_j  ,ff_k  ,n) * (1. - xd)
+                 + ffarr(ff_i+1,ff_j  ,ff_k  ,n) * xd;
+             Real ff01 =  ffarr(ff_i  ,ff_j  ,ff_k+1,n) * (1. - xd)
+                 + ffarr(ff_i+1,ff_j  ,ff_k+1,n) * xd;
+             Real ff10 =  ffarr(ff_i  ,ff_j+1,ff_k  ,n) * (1. - xd)
+                 + ffarr(ff_i+1,ff_j+1,ff_k  ,n) * xd;
+             Real ff11 =  ffarr(ff_i  ,ff_j+1,ff_k+1,n) * (1. - xd)
+                 + ffarr(ff_i+1,ff_j+1,ff_k+1,n) * xd;
+
+             Real fint =  ( ff00*(1.-yd)+ff10*yd ) * (1. - zd)
+                 + ( ff01*(1.-yd)+ff11*yd ) * zd;
+
+             frc(i,j,k,n) += dens(i,j,k,0) * fint;
+         });
      }
-
-     // allocate coarse force array
-     Box ffbx(IntVect(ff_ilo, ff_jlo, ff_klo), IntVect(ff_ihi, ff_jhi, ff_khi));
-     // not sure if want elixir, gpu::sync, or async_arena here...
-     FArrayBox ff_force(ffbx,AMREX_SPACEDIM);
-     const auto& ffarr = ff_force.array();
-
-     // Construct node-based coarse forcing
-     amrex::ParallelFor(ffbx, [ = ]
-     AMREX_GPU_DEVICE (int i, int j, int k ) noexcept
+     else if (TurbulentForcing::use_trig_tables)
      {
-         Real z = xlo[2] + ff_hz*(k-ff_klo);
-         Real y = xlo[1] + ff_hy*(j-ff_jlo);
-         Real x = xlo[0] + ff_hx*(i-ff_ilo);
-
-         for (int n = 0; n < AMREX_SPACEDIM; n++)
-             ffarr(i,j,k,n) = 0.0;
-
-         // forcedata (and Array4) has column-major layout
-         for (int kz = TurbulentForcing::mode_start*zstep; kz <= TurbulentForcing::nmodes*zstep; kz += zstep) {
-             for (int ky = TurbulentForcing::mode_start*ystep; ky <= TurbulentForcing::nmodes*ystep; ky += ystep) {
-                 for (int kx = TurbulentForcing::mode_start*xstep; kx <= TurbulentForcing::nmodes*xstep; kx += xstep)
-                 {
-                     Real kappa = sqrt( (kx*kx)/(Lx*Lx) + (ky*ky)/(Ly*Ly) + (kz*kz)/(Lz*Lz) );
-
-                     if (kappa <= kappaMax)
-                     {
-                         Real xT = cos(FTX(kx,ky,kz)*time + TAT(kx,ky,kz));
-
-                         if ( TurbulentForcing::div_free_force )
-                         {
-                             ffarr(i,j,k,0) += xT *
-                                 ( FAZ(kx,ky,kz)*TwoPi*(ky/Ly)
-                                   *   sin(TwoPi*kx*x/Lx+FPZX(kx,ky,kz))
-                                   *   cos(TwoPi*ky*y/Ly+FPZY(kx,ky,kz))
-                                   *   sin(TwoPi*kz*z/Lz+FPZZ(kx,ky,kz))
-                                   - FAY(kx,ky,kz)*TwoPi*(kz/Lz)
-                                   *   sin(TwoPi*kx*x/Lx+FPYX(kx,ky,kz))
-                                   *   sin(TwoPi*ky*y/Ly+FPYY(kx,ky,kz))
-                                   *   cos(TwoPi*kz*z/Lz+FPYZ(kx,ky,kz)) );
-
-                             ffarr(i,j,k,1) += xT *
-                                 ( FAX(kx,ky,kz)*TwoPi*(kz/Lz)
-                                   *   sin(TwoPi*kx*x/Lx+FPXX(kx,ky,kz))
-                                   *   sin(TwoPi*ky*y/Ly+FPXY(kx,ky,kz))
-                                   *   cos(TwoPi*kz*z/Lz+FPXZ(kx,ky,kz))
-                                   - FAZ(kx,ky,kz)*TwoPi*(kx/Lx)
-                                   *   cos(TwoPi*kx*x/Lx+FPZX(kx,ky,kz))
-                                   *   sin(TwoPi*ky*y/Ly+FPZY(kx,ky,kz))
-                                   *   sin(TwoPi*kz*z/Lz+FPZZ(kx,ky,kz)) );
-
-                             ffarr(i,j,k,2) += xT *
-                                 ( FAY(kx,ky,kz)*TwoPi*(kx/Lx)
-                                   *   cos(TwoPi*kx*x/Lx+FPYX(kx,ky,kz))
-                                   *   sin(TwoPi*ky*y/Ly+FPYY(kx,ky,kz))
-                                   *   sin(TwoPi*kz*z/Lz+FPYZ(kx,ky,kz))
-                                   - FAX(kx,ky,kz)*TwoPi*(ky/Ly)
-                                   *   sin(TwoPi*kx*x/Lx+FPXX(kx,ky,kz))
-                                   *   cos(TwoPi*ky*y/Ly+FPXY(kx,ky,kz))
-                                   *   sin(TwoPi*kz*z/Lz+FPXZ(kx,ky,kz)) );
-                         }
-                         else
-                         {
-
-                             ffarr(i,j,k,0) += xT*FAX(kx,ky,kz)*cos(TwoPi*kx*x/Lx+FPX(kx,ky,kz))
-                                 *                             sin(TwoPi*ky*y/Ly+FPY(kx,ky,kz))
-                                 *                             sin(TwoPi*kz*z/Lz+FPZ(kx,ky,kz));
-
-                             ffarr(i,j,k,1) += xT*FAY(kx,ky,kz)*sin(TwoPi*kx*x/Lx+FPX(kx,ky,kz))
-                                 *                             cos(TwoPi*ky*y/Ly+FPY(kx,ky,kz))
-                                 *                             sin(TwoPi*kz*z/Lz+FPZ(kx,ky,kz));
-
-                             ffarr(i,j,k,2) += xT*FAZ(kx,ky,kz)*sin(TwoPi*kx*x/Lx+FPX(kx,ky,kz))
-                                 *                             sin(TwoPi*ky*y/Ly+FPY(kx,ky,kz))
-                                 *                             cos(TwoPi*kz*z/Lz+FPZ(kx,ky,kz));
-                         }
-                     }
-                 }
-             }
-         }
-
          //
-         // For high aspect ratio domain, add more modes to break symmetry at a low level.
-         // We assume Lz is longer, Lx = Ly.
+         // Assemble the force from 1-D tables of sin/cos(TwoPi*k*x/L), so trig is only
+         // evaluated O(length * modes) times per direction. The tables are cached per
+         // level; only boxes reaching outside the cached range get their own tables.
+         // Per call, the cached spatial basis is only recombined with the time coefficients.
          //
-         for ( int kz = 1; kz <= zstep-1; kz++) {
-             for ( int ky = TurbulentForcing::mode_start; ky <= TurbulentForcing::nmodes*ystep; ky++) {
-                 for ( int kx = TurbulentForcing::mode_start; kx <= TurbulentForcing::nmodes*xstep; kx++)
-                 {
-                     Real kappa = sqrt( (kx*kx)/(Lx*Lx) + (ky*ky)/(Ly*Ly) + (kz*kz)/(Lz*Lz) );
-
-                     if (kappa <= kappaMax)
-                     {
-                         Real xT = cos(FTX(kx,ky,kz)*time + TAT(kx,ky,kz));
-
-                         if ( TurbulentForcing::div_free_force )
-                         {
-                             ffarr(i,j,k,0) += xT *
-                                 ( FAZ(kx,ky,kz)*TwoPi*(ky/Ly)
-                                   *   sin(TwoPi*kx*x/Lx+FPZX(kx,ky,kz))
-                                   *   cos(TwoPi*ky*y/Ly+FPZY(kx,ky,kz))
-                                   *   sin(TwoPi*kz*z/Lz+FPZZ(kx,ky,kz))
-                                   - FAY(kx,ky,kz)*TwoPi*(kz/Lz)
-                                   *   sin(TwoPi*kx*x/Lx+FPYX(kx,ky,kz))
-                                   *   sin(TwoPi*ky*y/Ly+FPYY(kx,ky,kz))
-                                   *   cos(TwoPi*kz*z/Lz+FPYZ(kx,ky,kz)) );
-
-                             ffarr(i,j,k,1) += xT *
-                                 ( FAX(kx,ky,kz)*TwoPi*(kz/Lz)
-                                   *   sin(TwoPi*kx*x/Lx+FPXX(kx,ky,kz))
-                                   *   sin(TwoPi*ky*y/Ly+FPXY(kx,ky,kz))
-                                   *   cos(TwoPi*kz*z/Lz+FPXZ(kx,ky,kz))
-                                   - FAZ(kx,ky,kz)*TwoPi*(kx/Lx)
-                                   *   cos(TwoPi*kx*x/Lx+FPZX(kx,ky,kz))
-                                   *   sin(TwoPi*ky*y/Ly+FPZY(kx,ky,kz))
-                                   *   sin(TwoPi*kz*z/Lz+FPZZ(kx,ky,kz)) );
-
-                             ffarr(i,j,k,2) += xT *
-                                 ( FAY(kx,ky,kz)*TwoPi*(kx/Lx)
-                                   *   cos(TwoPi*kx*x/Lx+FPYX(kx,ky,kz))
-                                   *   sin(TwoPi*ky*y/Ly+FPYY(kx,ky,kz))
-                                   *   sin(TwoPi*kz*z/Lz+FPYZ(kx,ky,kz))
-                                   - FAX(kx,ky,kz)*TwoPi*(ky/Ly)
-                                   *   sin(TwoPi*kx*x/Lx+FPXX(kx,ky,kz))
-                                   *   cos(TwoPi*ky*y/Ly+FPXY(kx,ky,kz))
-                                   *   sin(TwoPi*kz*z/Lz+FPXZ(kx,ky,kz)) );
-                         }
-                         else
-                         {
-
-                             ffarr(i,j,k,0) += xT*FAX(kx,ky,kz)*cos(TwoPi*kx*x/Lx+FPX(kx,ky,kz))
-                                 *                             sin(TwoPi*ky*y/Ly+FPY(kx,ky,kz))
-                                 *                             sin(TwoPi*kz*z/Lz+FPZ(kx,ky,kz));
-
-                             ffarr(i,j,k,1) += xT*FAY(kx,ky,kz)*sin(TwoPi*kx*x/Lx+FPX(kx,ky,kz))
-                                 *                             cos(TwoPi*ky*y/Ly+FPY(kx,ky,kz))
-                                 *                             sin(TwoPi*kz*z/Lz+FPZ(kx,ky,kz));
-
-                             ffarr(i,j,k,2) += xT*FAZ(kx,ky,kz)*sin(TwoPi*kx*x/Lx+FPX(kx,ky,kz))
-                                 *                             sin(TwoPi*ky*y/Ly+FPY(kx,ky,kz))
-                                 *                             cos(TwoPi*kz*z/Lz+FPZ(kx,ky,kz));
-                         }
-                     }
-                 }
-             }
+         const TrigTables& cached = getTrigTables(geom, level, kmax);
+
+         FArrayBox tabx, taby, tabz, xTfab;
+         Array4<Real const> tx, ty, tz;
+         if (cached.covered.contains(bx))
+         {
+             tx = cached.tab[0].const_array();
+             ty = cached.tab[1].const_array();
+             tz = cached.tab[2].const_array();
          }
-
-     });
-
-     // Need all of ffarr filled for next lambda
-     amrex::Gpu::synchronize();
-
-     // Now interpolate onto fine grid
-     // bx is the box we want to fill and may be smaller than force
-     auto const& dens = Scal.array(scalScomp);
-
-     amrex::ParallelFor(bx, AMREX_SPACEDIM, [ = ]
-     AMREX_GPU_DEVICE (int i, int j, int k, int n ) noexcept
-     {
-         int ff_k = k/TurbulentForcing::ff_factor;
-         int ff_j = j/TurbulentForcing::ff_factor;
-         int ff_i = i/TurbulentForcing::ff_factor;
-
-         Real zd = ( hz*(k-klo + 0.5) - ff_hz*(ff_k-ff_klo) )/ff_hz;
-         Real yd = ( hy*(j-jlo + 0.5) - ff_hy*(ff_j-ff_jlo) )/ff_hy;
-         Real xd = ( hx*(i-ilo + 0.5) - ff_hx*(ff_i-ff_ilo) )/ff_hx;
-
-         Real ff00 =  ffarr(ff_i  ,ff_j  ,ff_k  ,n) * (1. - xd)
-             + ffarr(ff_i+1,ff_j  ,ff_k  ,n) * xd;
-         Real ff01 =  ffarr(ff_i  ,ff_j  ,ff_k+1,n) * (1. - xd)
-             + ffarr(ff_i+1,ff_j  ,ff_k+1,n) * xd;
-         Real ff10 =  ffarr(ff_i  ,ff_j+1,ff_k  ,n) * (1. - xd)
-             + ffarr(ff_i+1,ff_j+1,ff_k  ,n) * xd;
-         Real ff11 =  ffarr(ff_i  ,ff_j+1,ff_k+1,n) * (1. - xd)
-             + ffarr(ff_i+1,ff_j+1,ff_k+1,n) * xd;
-
-         Real ff =  ( ff00*(1.-yd)+ff10*yd ) * (1. - zd)
-             + ( ff01*(1.-yd)+ff11*yd ) * zd;
-
-         frc(i,j,k,n) += dens(i,j,k,0) * ff;
-
-         // if ( i==0 && j==0 && k==0 ){
-         //   printf("%15.13e %15.13e %15.13e %15.13e %15.13e\n",
-         //          FTX(1,0,0), TAT(0,0,0),FAY(9,8,7), FPX(3,4,5), FPZZ(12,4,7) );
-         // }
-     });
-
-#else
-
-     //
-     // Original implementation using all 33 points in k-space.
-     // May be fast enough on GPU.
-     //
-
-     auto const& dens = Scal.array(scalScomp);
-
-     // Construct cell-centered forcing
-     amrex::ParallelFor(bx, [ = ]
-     AMREX_GPU_DEVICE (int i, int j, int k ) noexcept
+         else
+         {
+             fillTrigTable(tabx, bx.smallEnd(0), bx.bigEnd(0), kmax[0], problo[0], hx, 0.5, Lx);
+             fillTrigTable(taby, bx.smallEnd(1), bx.bigEnd(1), kmax[1], problo[1], hy, 0.5, Ly);
+             fillTrigTable(tabz, bx.smallEnd(2), bx.bigEnd(2), kmax[2], problo[2], hz, 0.5, Lz);
+             tx = tabx.const_array();
+             ty = taby.const_array();
+             tz = tabz.const_array();
+         }
+         fillTimeCoefficients(xTfab, time);
+         Elixir tabx_e = tabx.elixir();
+         Elixir taby_e = taby.elixir();
+         Elixir tabz_e = tabz.elixir();
+         Elixir xT_e   = xTfab.elixir();
+
+         Real const* xT    = xTfab.dataPtr();
+         int  const* midx  = TurbulentForcing::modeidx;
+         Real const* mdata = TurbulentForcing::modedata;
+         const int   nm    = TurbulentForcing::nmodes_active;
+         const bool  div_free = TurbulentForcing::div_free_force;
+
+         amrex::ParallelFor(bx, [=]
+         AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+         {
+             Real f[3];
+             TurbulentForcing::force_from_tables_k(i, j, k, f, tx, ty, tz,
+                                                   nm, midx, mdata, xT, div_free);
+             frc(i,j,k,0) += dens(i,j,k,0) * f[0];
+             frc(i,j,k,1) += dens(i,j,k,0) * f[1];
+             frc(i,j,k,2) += dens(i,j,k,0) * f[2];
+         });
+     }
+     else
      {
-         Real z = xlo[2] + hz*(k-klo + 0.5);
-         Real y = xlo[1] + hy*(j-jlo + 0.5);
-         Real x = xlo[0] + hx*(i-ilo + 0.5);
-
-         Real f1 = 0;
-         Real f2 = 0;
-         Real f3 = 0;
-
-         // forcedata (and Array4) has column-major layout
-         for (int kz = TurbulentForcing::mode_start*zstep; kz <= TurbulentForcing::nmodes*zstep; kz += zstep) {
-             for (int ky = TurbulentForcing::mode_start*ystep; ky <= TurbulentForcing::nmodes*ystep; ky += ystep) {
-                 for (int kx = TurbulentForcing::mode_start*xstep; kx <= TurbulentForcing::nmodes*xstep; kx += xstep)
-                 {
-                     Real kappa = sqrt( (kx*kx)/(Lx*Lx) + (ky*ky)/(Ly*Ly) + (kz*kz)/(Lz*Lz) );
-
-                     if (kappa <= kappaMax)
+         //
+         // Original implementation using all 33 points in k-space.
+         // May be fast enough on GPU.
+         //
+         // Construct cell-centered forcing
+         amrex::ParallelFor(bx, [ = ]
+         AMREX_GPU_DEVICE (int i, int j, int k ) noexcept
+         {
+             Real z = problo[2] + hz*(k + 0.5);
+             Real y = problo[1] + hy*(j + 0.5);
+             Real x = problo[0] + hx*(i + 0.5);
+
+             Real f1 = 0;
+             Real f2 = 0;
+             Real f3 = 0;
+
+             // forcedata (and Array4) has column-major layout
+             for (int kz = TurbulentForcing::mode_start*zstep; kz <= TurbulentForcing::nmodes*zstep; kz += zstep) {
+                 for (int ky = TurbulentForcing::mode_start*ystep; ky <= TurbulentForcing::nmodes*ystep; ky += ystep) {
+                     for (int kx = TurbulentForcing::mode_start*xstep; kx <= TurbulentForcing::nmodes*xstep; kx += xstep)
                      {
-                         Real xT = cos(FTX(kx,ky,kz)*time + TAT(kx,ky,kz));
+                         Real kappa = sqrt( (kx*kx)/(Lx*Lx) + (ky*ky)/(Ly*Ly) + (kz*kz)/(Lz*Lz) );
 
-                         // if ( i==0 && j==0 && k==0 && kx==0 && ky==0 && kx==0){
-                         //     printf("(0,0,0) : xT : %15.13e %15.13e %15.13e %15.13e\n",
-                         //         FTX(kx,ky,kz), time, TAT(kx,ky,kz), xT);
-                         //     Abort();
-                         // }
-
-
-                         if ( TurbulentForcing::div_free_force )
+                         if (kappa <= kappaMax)
                          {
-                             f1 += xT *
-                                 ( FAZ(kx,ky,kz)*TwoPi*(ky/Ly)
-                                   *   sin(TwoPi*kx*x/Lx+FPZX(kx,ky,kz))
-                                   *   cos(TwoPi*ky*y/Ly+FPZY(kx,ky,kz))
-                                   *   sin(TwoPi*kz*z/Lz+FPZZ(kx,ky,kz))
-                                   - FAY(kx,ky,kz)*TwoPi*(kz/Lz)
-                                   *   sin(TwoPi*kx*x/Lx+FPYX(kx,ky,kz))
-                                   *   sin(TwoPi*ky*y/Ly+FPYY(kx,ky,kz))
-                                   *   cos(TwoPi*kz*z/Lz+FPYZ(kx,ky,kz)) );
-
-                             f2 += xT *
-                                 ( FAX(kx,ky,kz)*TwoPi*(kz/Lz)
-                                   *   sin(TwoPi*kx*x/Lx+FPXX(kx,ky,kz))
-                                   *   sin(TwoPi*ky*y/Ly+FPXY(kx,ky,kz))
-                                   *   cos(TwoPi*kz*z/Lz+FPXZ(kx,ky,kz))
-                                   - FAZ(kx,ky,kz)*TwoPi*(kx/Lx)
-                                   *   cos(TwoPi*kx*x/Lx+FPZX(kx,ky,kz))
-                                   *   sin(TwoPi*ky*y/Ly+FPZY(kx,ky,kz))
-                                   *   sin(TwoPi*kz*z/Lz+FPZZ(kx,ky,kz)) );
-
-                             f3 += xT *
-                                 ( FAY(kx,ky,kz)*TwoPi*(kx/Lx)
-                                   *   cos(TwoPi*kx*x/Lx+FPYX(kx,ky,kz))
-                                   *   sin(TwoPi*ky*y/Ly+FPYY(kx,ky,kz))
-                                   *   sin(TwoPi*kz*z/Lz+FPYZ(kx,ky,kz))
-                                   - FAX(kx,ky,kz)*TwoPi*(ky/Ly)
-                                   *   sin(TwoPi*kx*x/Lx+FPXX(kx,ky,kz))
-                                   *   cos(TwoPi*ky*y/Ly+FPXY(kx,ky,kz))
-                                   *   sin(TwoPi*kz*z/Lz+FPXZ(kx,ky,kz)) );
-                         }
-                         else
-                         {
-
-                             f1 += xT*FAX(kx,ky,kz)*cos(TwoPi*kx*x/Lx+FPX(kx,ky,kz))
-                                 *                             sin(TwoPi*ky*y/Ly+FPY(kx,ky,kz))
-                                 *                             sin(TwoPi*kz*z/Lz+FPZ(kx,ky,kz));
-
-                             f2 += xT*FAY(kx,ky,kz)*sin(TwoPi*kx*x/Lx+FPX(kx,ky,kz))
-                                 *                             cos(TwoPi*ky*y/Ly+FPY(kx,ky,kz))
-                                 *                             sin(TwoPi*kz*z/Lz+FPZ(kx,ky,kz));
-
-                             f3 += xT*FAZ(kx,ky,kz)*sin(TwoPi*kx*x/Lx+FPX(kx,ky,kz))
-                                 *                             sin(TwoPi*ky*y/Ly+FPY(kx,ky,kz))
-                                 *                             cos(TwoPi*kz*z/Lz+FPZ(kx,ky,kz));
+                             Real xT = cos(FTX(kx,ky,kz)*time + TAT(kx,ky,kz));
+
+                             // if ( i==0 && j==0 && k==0 && kx==0 && ky==0 && kx==0){
+                             //     printf("(0,0,0) : xT : %15.13e %15.13e %15.13e %15.13e\n",
+                             //         FTX(kx,ky,kz), time, TAT(kx,ky,kz), xT);
+                             //     Abort();
+                             // }
+
+
+                             if ( TurbulentForcing::div_free_force )
+                             {
+                                 f1 += xT *
+                                     ( FAZ(kx,ky,kz)*TwoPi*(ky/Ly)
+                                       *   sin(TwoPi*kx*x/Lx+FPZX(kx,ky,kz))
+                                       *   cos(TwoPi*ky*y/Ly+FPZY(kx,ky,kz))
+                                       *   sin(TwoPi*kz*z/Lz+FPZZ(kx,ky,kz))
+                                       - FAY(kx,ky,kz)*TwoPi*(kz/Lz)
+                                       *   sin(TwoPi*kx*x/Lx+FPYX(kx,ky,kz))
+                                       *   sin(TwoPi*ky*y/Ly+FPYY(kx,ky,kz))
+                                       *   cos(TwoPi*kz*z/Lz+FPYZ(kx,ky,kz)) );
+
+                                 f2 += xT *
+                                     ( FAX(kx,ky,kz)*TwoPi*(kz/Lz)
+                                       *   sin(TwoPi*kx*x/Lx+FPXX(kx,ky,kz))
+                                       *   sin(TwoPi*ky*y/Ly+FPXY(kx,ky,kz))
+                                       *   cos(TwoPi*kz*z/Lz+FPXZ(kx,ky,kz))
+                                       - FAZ(kx,ky,kz)*TwoPi*(kx/Lx)
+                                       *   cos(TwoPi*kx*x/Lx+FPZX(kx,ky,kz))
+                                       *   sin(TwoPi*ky*y/Ly+FPZY(kx,ky,kz))
+                                       *   sin(TwoPi*kz*z/Lz+FPZZ(kx,ky,kz)) );
+
+                                 f3 += xT *
+                                     ( FAY(kx,ky,kz)*TwoPi*(kx/Lx)
+                                       *   cos(TwoPi*kx*x/Lx+FPYX(kx,ky,kz))
+                                       *   sin(TwoPi*ky*y/Ly+FPYY(kx,ky,kz))
+                                       *   sin(TwoPi*kz*z/Lz+FPYZ(kx,ky,kz))
+                                       - FAX(kx,ky,kz)*TwoPi*(ky/Ly)
+                                       *   sin(TwoPi*kx*x/Lx+FPXX(kx,ky,kz))
+                                       *   cos(TwoPi*ky*y/Ly+FPXY(kx,ky,kz))
+                                       *   sin(TwoPi*kz*z/Lz+FPXZ(kx,ky,kz)) );
+                             }
+                             else
+                             {
+
+                                 f1 += xT*FAX(kx,ky,kz)*cos(TwoPi*kx*x/Lx+FPX(kx,ky,kz))
+                                     *                             sin(TwoPi*ky*y/Ly+FPY(kx,ky,kz))
+                                     *                             sin(TwoPi*kz*z/Lz+FPZ(kx,ky,kz));
+
+                                 f2 += xT*FAY(kx,ky,kz)*sin(TwoPi*kx*x/Lx+FPX(kx,ky,kz))
+                                     *                             cos(TwoPi*ky*y/Ly+FPY(kx,ky,kz))
+                                     *                             sin(TwoPi*kz*z/Lz+FPZ(kx,ky,kz));
+
+                                 f3 += xT*FAZ(kx,ky,kz)*sin(TwoPi*kx*x/Lx+FPX(kx,ky,kz))
+                                     *                             sin(TwoPi*ky*y/Ly+FPY(kx,ky,kz))
+                                     *                             cos(TwoPi*kz*z/Lz+FPZ(kx,ky,kz));
+                             }
                          }
                      }
                  }
              }
-         }
-
-         //
-         // For high aspect ratio domain, add more modes to break symmetry at a low level.
-         // We assume Lz is longer, Lx = Ly.
-         //
-         for ( int kz = 1; kz <= zstep-1; kz++) {
-             for ( int ky = TurbulentForcing::mode_start; ky <= TurbulentForcing::nmodes*ystep; ky++) {
-                 for ( int kx = TurbulentForcing::mode_start; kx <= TurbulentForcing::nmodes*xstep; kx++)
-                 {
-                     Real kappa = sqrt( (kx*kx)/(Lx*Lx) + (ky*ky)/(Ly*Ly) + (kz*kz)/(Lz*Lz) );
 
-                     if (kappa <= kappaMax)
+             //
+             // For high aspect ratio domain, add more modes to break symmetry at a low level.
+             // We assume Lz is longer, Lx = Ly.
+             //
+             for ( int kz = 1; kz <= zstep-1; kz++) {
+                 for ( int ky = TurbulentForcing::mode_start; ky <= TurbulentForcing::nmodes*ystep; ky++) {
+                     for ( int kx = TurbulentForcing::mode_start; kx <= TurbulentForcing::nmodes*xstep; kx++)
                      {
-                         Real xT = cos(FTX(kx,ky,kz)*time + TAT(kx,ky,kz));
+                         Real kappa = sqrt( (kx*kx)/(Lx*Lx) + (ky*ky)/(Ly*Ly) + (kz*kz)/(Lz*Lz) );
 
-                         if ( TurbulentForcing::div_free_force )
+                         if (kappa <= kappaMax)
                          {
-                             f1 += xT *
-                                 ( FAZ(kx,ky,kz)*TwoPi*(ky/Ly)
-                                   *   sin(TwoPi*kx*x/Lx+FPZX(kx,ky,kz))
-                                   *   cos(TwoPi*ky*y/Ly+FPZY(kx,ky,kz))
-                                   *   sin(TwoPi*kz*z/Lz+FPZZ(kx,ky,kz))
-                                   - FAY(kx,ky,kz)*TwoPi*(kz/Lz)
-                                   *   sin(TwoPi*kx*x/Lx+FPYX(kx,ky,kz))
-                                   *   sin(TwoPi*ky*y/Ly+FPYY(kx,ky,kz))
-                                   *   cos(TwoPi*kz*z/Lz+FPYZ(kx,ky,kz)) );
-
-                             f2 += xT *
-                                 ( FAX(kx,ky,kz)*TwoPi*(kz/Lz)
-                                   *   sin(TwoPi*kx*x/Lx+FPXX(kx,ky,kz))
-                                   *   sin(TwoPi*ky*y/Ly+FPXY(kx,ky,kz))
-                                   *   cos(TwoPi*kz*z/Lz+FPXZ(kx,ky,kz))
-                                   - FAZ(kx,ky,kz)*TwoPi*(kx/Lx)
-                                   *   cos(TwoPi*kx*x/Lx+FPZX(kx,ky,kz))
-                                   *   sin(TwoPi*ky*y/Ly+FPZY(kx,ky,kz))
-                                   *   sin(TwoPi*kz*z/Lz+FPZZ(kx,ky,kz)) );
-
-                             f3 += xT *
-                                 ( FAY(kx,ky,kz)*TwoPi*(kx/Lx)
-                                   *   cos(TwoPi*kx*x/Lx+FPYX(kx,ky,kz))
-                                   *   sin(TwoPi*ky*y/Ly+FPYY(kx,ky,kz))
-                                   *   sin(TwoPi*kz*z/Lz+FPYZ(kx,ky,kz))
-                                   - FAX(kx,ky,kz)*TwoPi*(ky/Ly)
-                                   *   sin(TwoPi*kx*x/Lx+FPXX(kx,ky,kz))
-                                   *   cos(TwoPi*ky*y/Ly+FPXY(kx,ky,kz))
-                                   *   sin(TwoPi*kz*z/Lz+FPXZ(kx,ky,kz)) );
-                         }
-                         else
-                         {
-
-                             f1 += xT*FAX(kx,ky,kz)*cos(TwoPi*kx*x/Lx+FPX(kx,ky,kz))
-                                 *                             sin(TwoPi*ky*y/Ly+FPY(kx,ky,kz))
-                                 *                             sin(TwoPi*kz*z/Lz+FPZ(kx,ky,kz));
-
-                             f2 += xT*FAY(kx,ky,kz)*sin(TwoPi*kx*x/Lx+FPX(kx,ky,kz))
-                                 *                             cos(TwoPi*ky*y/Ly+FPY(kx,ky,kz))
-                                 *                             sin(TwoPi*kz*z/Lz+FPZ(kx,ky,kz));
-
-                             f3 += xT*FAZ(kx,ky,kz)*sin(TwoPi*kx*x/Lx+FPX(kx,ky,kz))
-                                 *                             sin(TwoPi*ky*y/Ly+FPY(kx,ky,kz))
-                                 *                             cos(TwoPi*kz*z/Lz+FPZ(kx,ky,kz));
+                             Real xT = cos(FTX(kx,ky,kz)*time + TAT(kx,ky,kz));
+
+                             if ( TurbulentForcing::div_free_force )
+                             {
+                                 f1 += xT *
+                                     ( FAZ(kx,ky,kz)*TwoPi*(ky/Ly)
+                                       *   sin(TwoPi*kx*x/Lx+FPZX(kx,ky,kz))
+                                       *   cos(TwoPi*ky*y/Ly+FPZY(kx,ky,kz))
+                                       *   sin(TwoPi*kz*z/Lz+FPZZ(kx,ky,kz))
+                                       - FAY(kx,ky,kz)*TwoPi*(kz/Lz)
+                                       *   sin(TwoPi*kx*x/Lx+FPYX(kx,ky,kz))
+                                       *   sin(TwoPi*ky*y/Ly+FPYY(kx,ky,kz))
+                                       *   cos(TwoPi*kz*z/Lz+FPYZ(kx,ky,kz)) );
+
+                                 f2 += xT *
+                                     ( FAX(kx,ky,kz)*TwoPi*(kz/Lz)
+                                       *   sin(TwoPi*kx*x/Lx+FPXX(kx,ky,kz))
+                                       *   sin(TwoPi*ky*y/Ly+FPXY(kx,ky,kz))
+                                       *   cos(TwoPi*kz*z/Lz+FPXZ(kx,ky,kz))
+                                       - FAZ(kx,ky,kz)*TwoPi*(kx/Lx)
+                                       *   cos(TwoPi*kx*x/Lx+FPZX(kx,ky,kz))
+                                       *   sin(TwoPi*ky*y/Ly+FPZY(kx,ky,kz))
+                                       *   sin(TwoPi*kz*z/Lz+FPZZ(kx,ky,kz)) );
+
+                                 f3 += xT *
+                                     ( FAY(kx,ky,kz)*TwoPi*(kx/Lx)
+                                       *   cos(TwoPi*kx*x/Lx+FPYX(kx,ky,kz))
+                                       *   sin(TwoPi*ky*y/Ly+FPYY(kx,ky,kz))
+                                       *   sin(TwoPi*kz*z/Lz+FPYZ(kx,ky,kz))
+                                       - FAX(kx,ky,kz)*TwoPi*(ky/Ly)
+                                       *   sin(TwoPi*kx*x/Lx+FPXX(kx,ky,kz))
+                                       *   cos(TwoPi*ky*y/Ly+FPXY(kx,ky,kz))
+                                       *   sin(TwoPi*kz*z/Lz+FPXZ(kx,ky,kz)) );
+                             }
+                             else
+                             {
+
+                                 f1 += xT*FAX(kx,ky,kz)*cos(TwoPi*kx*x/Lx+FPX(kx,ky,kz))
+                                     *                             sin(TwoPi*ky*y/Ly+FPY(kx,ky,kz))
+                                     *                             sin(TwoPi*kz*z/Lz+FPZ(kx,ky,kz));
+
+                                 f2 += xT*FAY(kx,ky,kz)*sin(TwoPi*kx*x/Lx+FPX(kx,ky,kz))
+                                     *                             cos(TwoPi*ky*y/Ly+FPY(kx,ky,kz))
+                                     *                             sin(TwoPi*kz*z/Lz+FPZ(kx,ky,kz));
+
+                                 f3 += xT*FAZ(kx,ky,kz)*sin(TwoPi*kx*x/Lx+FPX(kx,ky,kz))
+                                     *                             sin(TwoPi*ky*y/Ly+FPY(kx,ky,kz))
+                                     *                             cos(TwoPi*kz*z/Lz+FPZ(kx,ky,kz));
+                             }
                          }
                      }
                  }
              }
-         }
 
-         frc(i,j,k,0) += dens(i,j,k,0) * f1;
-         frc(i,j,k,1) += dens(i,j,k,0) * f2;
-         frc(i,j,k,2) += dens(i,j,k,0) * f3;
-
-         // if ( i==0 && j==0 && k==0 ){
-         //   printf("(0,0,0) : %15.13e %15.13e %15.13e\n",
-         //          f1, f2, f3);
-         // }
-         // if ( i==16 && j==16 && k==16 ){
-         //   printf("(16,16,16) : %15.13e %15.13e %15.13e\n",
-         //          f1, f2, f3);
-         // }
-         // if ( i==25 && j==12 && k==3 ){
-         //   printf("(25,12,3) : %15.13e %15.13e %15.13e\n",
-         //          f1, f2, f3);
-         // }
-
-     });
-#endif // Fast Force
+             frc(i,j,k,0) += dens(i,j,k,0) * f1;
+             frc(i,j,k,1) += dens(i,j,k,0) * f2;
+             frc(i,j,k,2) += dens(i,j,k,0) * f3;
+
+             // if ( i==0 && j==0 && k==0 ){
+             //   printf("(0,0,0) : %15.13e %15.13e %15.13e\n",
+             //          f1, f2, f3);
+             // }
+             // if ( i==16 && j==16 && k==16 ){
+             //   printf("(16,16,16) : %15.13e %15.13e %15.13e\n",
+             //          f1, f2, f3);
+             // }
+             // if ( i==25 && j==12 && k==3 ){
+             //   printf("(25,12,3) : %15.13e %15.13e %15.13e\n",
+             //          f1, f2, f3);
+             // }
+
+         });
+     }
 #endif // Turbulent forcing
 
    }
@@ -784,3 +763,57 @@ NavierStokesBase::getForce (FArrayBox&       force,
                      << std::endl << "---" << std::endl;
    }
 }
+
+//
+// Bound on |F|/rho for estTimeStep, used only with turb.use_force_bound = 1.
+// The turbulent forcing is a sum of modes with unit-bounded spatial factors,
+// so the sum of |xT*amplitude| over the active modes bounds it at any point
+// (also after the fast-forcing interpolation). The bound is not sharp, so it
+// can give a smaller dt than evaluating getForce.
+//
+#ifdef AMREX_USE_TURBULENT_FORCING
+bool
+NavierStokes::getForceBound (Real          time,
+                             Vector<Real>& fbound)
+{
+    if (!TurbulentForcing::use_force_bound) {
+        return NavierStokesBase::getForceBound(time,fbound);
+    }
+
+    fbound.assign(AMREX_SPACEDIM,0.0);
+
+    if ( std::abs(gravity) > 0.0001) {
+        fbound[AMREX_SPACEDIM-1] = std::abs(gravity);
+    }
+
+    Real const* md       = TurbulentForcing::modedata;
+    const int   nm       = TurbulentForcing::nmodes_active;
+    const bool  div_free = TurbulentForcing::div_free_force;
+
+    ReduceOps<ReduceOpSum,ReduceOpSum,ReduceOpSum> reduce_op;
+    ReduceData<Real,Real,Real> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+
+    reduce_op.eval(nm, reduce_data, [=]
+    AMREX_GPU_DEVICE (int m) -> ReduceTuple
+    {
+        using namespace TurbulentForcing;
+        Real const* amp = md + m*mode_ncoef + md_amp;
+        Real xT = std::abs(std::cos(md[m*mode_ncoef+md_ftx]*time + md[m*mode_ncoef+md_tat]));
+        if (div_free) {
+            return { xT*(std::abs(amp[0]) + std::abs(amp[1])),
+                     xT*(std::abs(amp[2]) + std::abs(amp[3])),
+                     xT*(std::abs(amp[4]) + std::abs(amp[5])) };
+        } else {
+            return { xT*std::abs(amp[0]), xT*std::abs(amp[1]), xT*std::abs(amp[2]) };
+        }
+    });
+
+    ReduceTuple hv = reduce_data.value();
+    fbound[0] += amrex::get<0>(hv);
+    fbound[1] += amrex::get<1>(hv);
+    fbound[2] += amrex::get<2>(hv);
+
+    return true;
+}
+#endif